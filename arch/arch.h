@@ -12,6 +12,7 @@
  */
 #define ARCH_CAP_SSE41			( 0x01 )
 #define ARCH_CAP_AVX2			( 0x04 )
+#define ARCH_CAP_AVX512BW		( 0x08 )
 #define ARCH_CAP_NEON			( 0x10 )
 #define ARCH_CAP_ALTIVEC		( 0x20 )
 
@@ -22,14 +23,20 @@
 #    define _ARCH_GCC_VERSION	( __GNUC__ * 100 + __GNUC_MINOR__ * 10 + __GNUC_PATCHLEVEL__ )
 #  endif
 /* import architectured depentent stuffs and SIMD vectors */
-#  if defined(__AVX2__)
+#  if defined(__AVX512BW__)
+#    include "x86_64_avx512/arch_util.h"
+#    include "x86_64_avx512/vector.h"
+#  elif defined(__AVX2__)
 #    include "x86_64_avx2/arch_util.h"
 #    include "x86_64_avx2/vector.h"
 #  elif defined(__SSE4_1__)
 #    include "x86_64_sse41/arch_util.h"
 #    include "x86_64_sse41/vector.h"
 #  elif !defined(ARCH_CAP)		/* arch.h will be included without SIMD flag to check capability */
-#    error "No SIMD instruction set enabled. Check if SSE4.1 or AVX2 instructions are available and add `-msse4.1' or `-mavx2' to CFLAGS."
+#    error "No SIMD instruction set enabled. Check if SSE4.1, AVX2, or AVX512BW instructions are available and add `-msse4.1' or `-mavx2' to CFLAGS."
+#  endif
+#  if defined(__SSE4_1__)
+#    include "vector_wide.h"		/* 128- and 256-cell vectors on top of the 64-cell ones */
 #  endif
 
 /* map reverse-complement sequence out of the canonical-formed address */
@@ -42,6 +49,11 @@
  * CPUID.(EAX=07H, ECX=0H):EBX.AVX2[bit 5]==1 &&
  * CPUID.(EAX=07H, ECX=0H):EBX.BMI1[bit 3]==1 &&
  * CPUID.(EAX=80000001H):ECX.LZCNT[bit 5]==1
+ *
+ * AVX512BW additionally requires
+ * CPUID.(EAX=07H, ECX=0H):EBX.AVX512F[bit 16]==1 &&
+ * CPUID.(EAX=07H, ECX=0H):EBX.AVX512BW[bit 30]==1 &&
+ * XCR0[7:5]==111b, XCR0[2:1]==11b (zmm and k-register states enabled by OS)
  */
 #define arch_cap() ({ \
 	uint32_t eax, ebx, ecx, edx; \
@@ -54,11 +66,20 @@
 		: "a"(0x07), "c"(0x00)); \
 	uint64_t avx2_cap = (ebx & (0x01<<5)) != 0; \
 	uint64_t bmi1_cap = (ebx & (0x01<<3)) != 0; \
+	uint64_t avx512_cap = (ebx & ((0x01<<16) | (0x01<<30))) == ((0x01<<16) | (0x01<<30)); \
+	if(avx512_cap) { \
+		__asm__ volatile("xgetbv" \
+			: "=a"(eax), "=d"(edx) \
+			: "c"(0x00)); \
+		avx512_cap = (eax & 0xe6) == 0xe6; \
+	} \
 	__asm__ volatile("cpuid" \
 		: "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) \
 		: "a"(0x80000001), "c"(0x00)); \
 	uint64_t lzcnt_cap = (ecx & (0x01<<5)) != 0; \
-	((sse4_cap != 0) ? ARCH_CAP_SSE41 : 0) | ((avx2_cap && bmi1_cap && lzcnt_cap) ? ARCH_CAP_AVX2 : 0); \
+	((sse4_cap != 0) ? ARCH_CAP_SSE41 : 0) \
+		| ((avx2_cap && bmi1_cap && lzcnt_cap) ? ARCH_CAP_AVX2 : 0) \
+		| ((avx2_cap && bmi1_cap && lzcnt_cap && avx512_cap) ? ARCH_CAP_AVX512BW : 0); \
 })
 
 #endif
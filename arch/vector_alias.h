@@ -125,6 +125,12 @@
 #define _mask_n			_vec_alias_join2(_mask_, nvec_prefix)
 #define _mask_w			_vec_alias_join2(_mask_, wvec_prefix)
 
+/* compare and mask */
+#define _mask_eq_n		_vec_alias_join2(_mask_eq_, nvec_prefix)
+#define _mask_gt_n		_vec_alias_join2(_mask_gt_, nvec_prefix)
+#define _mask_eq_w		_vec_alias_join2(_mask_eq_, wvec_prefix)
+#define _mask_gt_w		_vec_alias_join2(_mask_gt_, wvec_prefix)
+
 /* horizontal max */
 #define _hmax_n			_vec_alias_join2(_hmax_, nvec_prefix)
 #define _hmax_w			_vec_alias_join2(_hmax_, wvec_prefix)
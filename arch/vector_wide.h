@@ -0,0 +1,352 @@
+
+/**
+ * @file vector_wide.h
+ *
+ * @brief 128- and 256-cell vectors for the wide-band kernels, composed of a pair of the
+ * next narrower vectors (v128i8_t = 2 x v64i8_t, v256i8_t = 2 x v128i8_t, and 16bit
+ * counterparts). The halves are processed with the backend (SSE4.1, AVX2, or AVX-512BW)
+ * macros, so the composition works on all the instruction sets.
+ *
+ * The 256-cell macros evaluate the operands once and keep them in temporaries named after
+ * the vector type.
+ */
+#ifndef _VECTOR_WIDE_H_INCLUDED
+#define _VECTOR_WIDE_H_INCLUDED
+
+/**
+ * @struct v128_mask_s
+ *
+ * @brief common 128cell-wide mask type, lower 64 cells in m[0]
+ */
+typedef struct v128_mask_s {
+	uint64_t m[2];
+} v128_mask_t;
+typedef struct v128_mask_s v128i8_mask_t;
+typedef struct v128_mask_s v128i16_mask_t;
+
+/**
+ * @union v128_mask_u
+ */
+typedef union v128_mask_u {
+	v128_mask_t mask;
+	uint64_t all[2];
+} v128_masku_t;
+typedef union v128_mask_u v128i8_masku_t;
+typedef union v128_mask_u v128i16_masku_t;
+
+/**
+ * @struct v256_mask_s
+ *
+ * @brief common 256cell-wide mask type, lower 64 cells in m[0]
+ */
+typedef struct v256_mask_s {
+	uint64_t m[4];
+} v256_mask_t;
+typedef struct v256_mask_s v256i8_mask_t;
+typedef struct v256_mask_s v256i16_mask_t;
+
+/**
+ * @union v256_mask_u
+ */
+typedef union v256_mask_u {
+	v256_mask_t mask;
+	uint64_t all[4];
+} v256_masku_t;
+typedef union v256_mask_u v256i8_masku_t;
+typedef union v256_mask_u v256i16_masku_t;
+
+/* vector types: lower cells in lo */
+typedef struct v128i8_s {
+	v64i8_t lo, hi;
+} v128i8_t;
+typedef struct v256i8_s {
+	v128i8_t lo, hi;
+} v256i8_t;
+typedef struct v128i16_s {
+	v64i16_t lo, hi;
+} v128i16_t;
+typedef struct v256i16_s {
+	v128i16_t lo, hi;
+} v256i16_t;
+
+/* cell counts of the halves */
+#define _V128I8_H					( 64 )
+#define _V256I8_H					( 128 )
+
+/* join macros */
+#define _wv_cat_intl(a, b)			a##b
+#define _wv_cat(a, b)				_wv_cat_intl(a, b)
+#define _wv_tmp(_i, _w)				_wv_cat(_wv_cat(__wv, _i), _w)
+
+/* apply (_w: wide prefix, _h: half prefix, _op: operation prefix) */
+#define _wv_x(_w, _h, _op) ( \
+	(_w##_t){ _op##_h(), _op##_h() } \
+)
+#define _wv_i(_w, _h, _op, imm) ( \
+	(_w##_t){ _op##_h(imm), _op##_h(imm) } \
+)
+#define _wv_vi(_w, _h, _op, a, imm) ({ \
+	_w##_t _wv_tmp(0, _w) = (a); \
+	(_w##_t){ _op##_h(_wv_tmp(0, _w).lo, (imm)), _op##_h(_wv_tmp(0, _w).hi, (imm)) }; \
+})
+#define _wv_vv(_w, _h, _op, a, b) ({ \
+	_w##_t _wv_tmp(0, _w) = (a), _wv_tmp(1, _w) = (b); \
+	(_w##_t){ \
+		_op##_h(_wv_tmp(0, _w).lo, _wv_tmp(1, _w).lo), \
+		_op##_h(_wv_tmp(0, _w).hi, _wv_tmp(1, _w).hi) \
+	}; \
+})
+
+/* load and store */
+#define _wv_load(_w, _h, _op, p) ( \
+	(_w##_t){ \
+		_op##_h((uint8_t const *)(p)), \
+		_op##_h((uint8_t const *)(p) + sizeof(_h##_t)) \
+	} \
+)
+#define _wv_store(_w, _h, _op, p, a) { \
+	uint8_t *_wv_tmp(0, _w) = (uint8_t *)(p); \
+	_w##_t _wv_tmp(1, _w) = (a); \
+	_op##_h(_wv_tmp(0, _w), _wv_tmp(1, _w).lo); \
+	_op##_h(_wv_tmp(0, _w) + sizeof(_h##_t), _wv_tmp(1, _w).hi); \
+}
+
+/* masks of the halves are concatenated (_m: mask width) */
+#define _wv_mask_u64(m)				( ((v64_masku_t){ .mask = (m) }).all )
+#define _wv_mask_cat_128(l, h)		( (v128_mask_t){ .m = { _wv_mask_u64(l), _wv_mask_u64(h) } } )
+#define _wv_mask_cat_256(l, h) ({ \
+	v128_mask_t _wv_tmp(0, m256) = (l), _wv_tmp(1, m256) = (h); \
+	(v256_mask_t){ .m = { \
+		_wv_tmp(0, m256).m[0], _wv_tmp(0, m256).m[1], \
+		_wv_tmp(1, m256).m[0], _wv_tmp(1, m256).m[1] \
+	} }; \
+})
+#define _wv_mask(_m, _w, _h, _op, a) ({ \
+	_w##_t _wv_tmp(0, _w) = (a); \
+	_wv_mask_cat_##_m(_op##_h(_wv_tmp(0, _w).lo), _op##_h(_wv_tmp(0, _w).hi)); \
+})
+#define _wv_mask_vv(_m, _w, _h, _op, a, b) ({ \
+	_w##_t _wv_tmp(0, _w) = (a), _wv_tmp(1, _w) = (b); \
+	_wv_mask_cat_##_m( \
+		_op##_h(_wv_tmp(0, _w).lo, _wv_tmp(1, _w).lo), \
+		_op##_h(_wv_tmp(0, _w).hi, _wv_tmp(1, _w).hi) \
+	); \
+})
+
+/* insert and extract (imm must be a constant) */
+#define _wv_ins(_h, _n, a, val, imm) { \
+	if((imm) < (_n)) { \
+		_ins_##_h((a).lo, (val), (imm) & ((_n) - 1)); \
+	} else { \
+		_ins_##_h((a).hi, (val), (imm) & ((_n) - 1)); \
+	} \
+}
+#define _wv_ext(_h, _n, a, imm) ( \
+	((imm) < (_n)) ? _ext_##_h((a).lo, (imm) & ((_n) - 1)) : _ext_##_h((a).hi, (imm) & ((_n) - 1)) \
+)
+
+/*
+ * byte shift by one (imm is ignored as in the v64i8_t implementations); the byte crossing
+ * the halves is carried with _bslc and _bsrc, which take the adjacent vector as the source
+ */
+#define _wv_bsl(_w, _h, a) ({ \
+	_w##_t _wv_tmp(0, _w) = (a); \
+	(_w##_t){ _bsl_##_h(_wv_tmp(0, _w).lo, 1), _bslc_##_h(_wv_tmp(0, _w).hi, _wv_tmp(0, _w).lo) }; \
+})
+#define _wv_bsr(_w, _h, a) ({ \
+	_w##_t _wv_tmp(0, _w) = (a); \
+	(_w##_t){ _bsrc_##_h(_wv_tmp(0, _w).lo, _wv_tmp(0, _w).hi), _bsr_##_h(_wv_tmp(0, _w).hi, 1) }; \
+})
+#define _wv_bslc(_w, _h, a, b) ({ \
+	_w##_t _wv_tmp(0, _w) = (a), _wv_tmp(1, _w) = (b); \
+	(_w##_t){ _bslc_##_h(_wv_tmp(0, _w).lo, _wv_tmp(1, _w).hi), _bslc_##_h(_wv_tmp(0, _w).hi, _wv_tmp(0, _w).lo) }; \
+})
+#define _wv_bsrc(_w, _h, a, b) ({ \
+	_w##_t _wv_tmp(0, _w) = (a), _wv_tmp(1, _w) = (b); \
+	(_w##_t){ _bsrc_##_h(_wv_tmp(0, _w).lo, _wv_tmp(0, _w).hi), _bsrc_##_h(_wv_tmp(0, _w).hi, _wv_tmp(1, _w).lo) }; \
+})
+
+/* horizontal max */
+#define _wv_hmax(_w, _h, a) ({ \
+	_w##_t _wv_tmp(0, _w) = (a); \
+	int16_t _wv_tmp(1, _w) = _hmax_##_h(_wv_tmp(0, _w).lo), _wv_tmp(2, _w) = _hmax_##_h(_wv_tmp(0, _w).hi); \
+	(int16_t)(_wv_tmp(1, _w) > _wv_tmp(2, _w) ? _wv_tmp(1, _w) : _wv_tmp(2, _w)); \
+})
+
+
+/*
+ * 128-cell operations are defined as inline functions: the 256-cell macros below are built
+ * on the same helpers, and a macro is not expanded again inside its own expansion.
+ */
+#define _wv_fn_x(_w, _h, _op) \
+	static inline _w##_t _op##_w(void) { return((_w##_t){ _op##_h(), _op##_h() }); }
+#define _wv_fn_i(_w, _h, _op) \
+	static inline _w##_t _op##_w(int x) { return((_w##_t){ _op##_h(x), _op##_h(x) }); }
+#define _wv_fn_vi(_w, _h, _op) \
+	static inline _w##_t _op##_w(_w##_t a, int imm) { return((_w##_t){ _op##_h(a.lo, imm), _op##_h(a.hi, imm) }); }
+#define _wv_fn_vv(_w, _h, _op) \
+	static inline _w##_t _op##_w(_w##_t a, _w##_t b) { return((_w##_t){ _op##_h(a.lo, b.lo), _op##_h(a.hi, b.hi) }); }
+#define _wv_fn_load(_w, _h, _op) \
+	static inline _w##_t _op##_w(void const *p) { return(_wv_load(_w, _h, _op, p)); }
+#define _wv_fn_store(_w, _h, _op) \
+	static inline void _op##_w(void *p, _w##_t a) _wv_store(_w, _h, _op, p, a)
+#define _wv_fn_mask(_w, _h, _op) \
+	static inline v128_mask_t _op##_w(_w##_t a) { return(_wv_mask_cat_128(_op##_h(a.lo), _op##_h(a.hi))); }
+#define _wv_fn_mask_vv(_w, _h, _op) \
+	static inline v128_mask_t _op##_w(_w##_t a, _w##_t b) { return(_wv_mask_cat_128(_op##_h(a.lo, b.lo), _op##_h(a.hi, b.hi))); }
+
+/* 8bit 128cell */
+_wv_fn_load(v128i8, v64i8, _load_)
+_wv_fn_load(v128i8, v64i8, _loadu_)
+_wv_fn_store(v128i8, v64i8, _store_)
+_wv_fn_store(v128i8, v64i8, _storeu_)
+_wv_fn_i(v128i8, v64i8, _set_)
+_wv_fn_x(v128i8, v64i8, _zero_)
+_wv_fn_vv(v128i8, v64i8, _and_)
+_wv_fn_vv(v128i8, v64i8, _or_)
+_wv_fn_vv(v128i8, v64i8, _xor_)
+_wv_fn_vv(v128i8, v64i8, _andn_)
+_wv_fn_vv(v128i8, v64i8, _add_)
+_wv_fn_vv(v128i8, v64i8, _sub_)
+_wv_fn_vv(v128i8, v64i8, _adds_)
+_wv_fn_vv(v128i8, v64i8, _subs_)
+_wv_fn_vv(v128i8, v64i8, _max_)
+_wv_fn_vv(v128i8, v64i8, _min_)
+_wv_fn_vv(v128i8, v64i8, _shuf_)
+_wv_fn_vv(v128i8, v64i8, _eq_)
+_wv_fn_vv(v128i8, v64i8, _gt_)
+_wv_fn_vi(v128i8, v64i8, _shl_)
+_wv_fn_vi(v128i8, v64i8, _shr_)
+_wv_fn_vi(v128i8, v64i8, _sar_)
+_wv_fn_mask(v128i8, v64i8, _mask_)
+_wv_fn_mask_vv(v128i8, v64i8, _mask_eq_)
+_wv_fn_mask_vv(v128i8, v64i8, _mask_gt_)
+static inline v128i8_t _bsl_v128i8(v128i8_t a, int imm) { return((v128i8_t){ _bsl_v64i8(a.lo, 1), _bslc_v64i8(a.hi, a.lo) }); }
+static inline v128i8_t _bsr_v128i8(v128i8_t a, int imm) { return((v128i8_t){ _bsrc_v64i8(a.lo, a.hi), _bsr_v64i8(a.hi, 1) }); }
+static inline v128i8_t _bslc_v128i8(v128i8_t a, v128i8_t b) { return((v128i8_t){ _bslc_v64i8(a.lo, b.hi), _bslc_v64i8(a.hi, a.lo) }); }
+static inline v128i8_t _bsrc_v128i8(v128i8_t a, v128i8_t b) { return((v128i8_t){ _bsrc_v64i8(a.lo, a.hi), _bsrc_v64i8(a.hi, b.lo) }); }
+#define _ins_v128i8(a, val, imm)	_wv_ins(v64i8, _V128I8_H, a, val, imm)
+#define _ext_v128i8(a, imm)			_wv_ext(v64i8, _V128I8_H, a, imm)
+#define _from_v16i8_v128i8(x)		( (v128i8_t){ _from_v16i8_v64i8(x), _from_v16i8_v64i8(x) } )
+#define _from_v32i8_v128i8(x)		( (v128i8_t){ _from_v32i8_v64i8(x), _from_v32i8_v64i8(x) } )
+#define _to_v16i8_v128i8(x)			_to_v16i8_v64i8((x).lo)
+#define _to_v32i8_v128i8(x)			_to_v32i8_v64i8((x).lo)
+
+/* 16bit 128cell */
+_wv_fn_load(v128i16, v64i16, _load_)
+_wv_fn_load(v128i16, v64i16, _loadu_)
+_wv_fn_store(v128i16, v64i16, _store_)
+_wv_fn_store(v128i16, v64i16, _storeu_)
+_wv_fn_i(v128i16, v64i16, _set_)
+_wv_fn_x(v128i16, v64i16, _zero_)
+_wv_fn_vv(v128i16, v64i16, _and_)
+_wv_fn_vv(v128i16, v64i16, _or_)
+_wv_fn_vv(v128i16, v64i16, _xor_)
+_wv_fn_vv(v128i16, v64i16, _andn_)
+_wv_fn_vv(v128i16, v64i16, _add_)
+_wv_fn_vv(v128i16, v64i16, _sub_)
+_wv_fn_vv(v128i16, v64i16, _max_)
+_wv_fn_vv(v128i16, v64i16, _min_)
+_wv_fn_vv(v128i16, v64i16, _eq_)
+_wv_fn_vv(v128i16, v64i16, _gt_)
+_wv_fn_mask(v128i16, v64i16, _mask_)
+static inline int16_t _hmax_v128i16(v128i16_t a) { return(_wv_hmax(v128i16, v64i16, a)); }
+
+/* 8bit 256cell */
+#define _load_v256i8(p)				_wv_load(v256i8, v128i8, _load_, p)
+#define _loadu_v256i8(p)			_wv_load(v256i8, v128i8, _loadu_, p)
+#define _store_v256i8(p, a)			_wv_store(v256i8, v128i8, _store_, p, a)
+#define _storeu_v256i8(p, a)		_wv_store(v256i8, v128i8, _storeu_, p, a)
+#define _set_v256i8(x)				_wv_i(v256i8, v128i8, _set_, x)
+#define _zero_v256i8()				_wv_x(v256i8, v128i8, _zero_)
+#define _and_v256i8(a, b)			_wv_vv(v256i8, v128i8, _and_, a, b)
+#define _or_v256i8(a, b)			_wv_vv(v256i8, v128i8, _or_, a, b)
+#define _xor_v256i8(a, b)			_wv_vv(v256i8, v128i8, _xor_, a, b)
+#define _andn_v256i8(a, b)			_wv_vv(v256i8, v128i8, _andn_, a, b)
+#define _add_v256i8(a, b)			_wv_vv(v256i8, v128i8, _add_, a, b)
+#define _sub_v256i8(a, b)			_wv_vv(v256i8, v128i8, _sub_, a, b)
+#define _adds_v256i8(a, b)			_wv_vv(v256i8, v128i8, _adds_, a, b)
+#define _subs_v256i8(a, b)			_wv_vv(v256i8, v128i8, _subs_, a, b)
+#define _max_v256i8(a, b)			_wv_vv(v256i8, v128i8, _max_, a, b)
+#define _min_v256i8(a, b)			_wv_vv(v256i8, v128i8, _min_, a, b)
+#define _shuf_v256i8(a, b)			_wv_vv(v256i8, v128i8, _shuf_, a, b)
+#define _eq_v256i8(a, b)			_wv_vv(v256i8, v128i8, _eq_, a, b)
+#define _gt_v256i8(a, b)			_wv_vv(v256i8, v128i8, _gt_, a, b)
+#define _ins_v256i8(a, val, imm) { \
+	if((imm) < _V256I8_H) { \
+		_ins_v128i8((a).lo, (val), (imm) & (_V256I8_H - 1)); \
+	} else { \
+		_ins_v128i8((a).hi, (val), (imm) & (_V256I8_H - 1)); \
+	} \
+}
+#define _ext_v256i8(a, imm) ( \
+	((imm) < _V256I8_H) ? _ext_v128i8((a).lo, (imm) & (_V256I8_H - 1)) : _ext_v128i8((a).hi, (imm) & (_V256I8_H - 1)) \
+)
+#define _bsl_v256i8(a, imm)			_wv_bsl(v256i8, v128i8, a)
+#define _bsr_v256i8(a, imm)			_wv_bsr(v256i8, v128i8, a)
+#define _shl_v256i8(a, imm)			_wv_vi(v256i8, v128i8, _shl_, a, imm)
+#define _shr_v256i8(a, imm)			_wv_vi(v256i8, v128i8, _shr_, a, imm)
+#define _sar_v256i8(a, imm)			_wv_vi(v256i8, v128i8, _sar_, a, imm)
+#define _mask_v256i8(a)				_wv_mask(256, v256i8, v128i8, _mask_, a)
+#define _mask_eq_v256i8(a, b)		_wv_mask_vv(256, v256i8, v128i8, _mask_eq_, a, b)
+#define _mask_gt_v256i8(a, b)		_wv_mask_vv(256, v256i8, v128i8, _mask_gt_, a, b)
+#define _from_v16i8_v256i8(x)		( (v256i8_t){ _from_v16i8_v128i8(x), _from_v16i8_v128i8(x) } )
+#define _from_v32i8_v256i8(x)		( (v256i8_t){ _from_v32i8_v128i8(x), _from_v32i8_v128i8(x) } )
+#define _to_v16i8_v256i8(x)			_to_v16i8_v128i8((x).lo)
+#define _to_v32i8_v256i8(x)			_to_v32i8_v128i8((x).lo)
+
+/* 16bit 256cell */
+#define _load_v256i16(p)			_wv_load(v256i16, v128i16, _load_, p)
+#define _loadu_v256i16(p)			_wv_load(v256i16, v128i16, _loadu_, p)
+#define _store_v256i16(p, a)		_wv_store(v256i16, v128i16, _store_, p, a)
+#define _storeu_v256i16(p, a)		_wv_store(v256i16, v128i16, _storeu_, p, a)
+#define _set_v256i16(x)				_wv_i(v256i16, v128i16, _set_, x)
+#define _zero_v256i16()				_wv_x(v256i16, v128i16, _zero_)
+#define _and_v256i16(a, b)			_wv_vv(v256i16, v128i16, _and_, a, b)
+#define _or_v256i16(a, b)			_wv_vv(v256i16, v128i16, _or_, a, b)
+#define _xor_v256i16(a, b)			_wv_vv(v256i16, v128i16, _xor_, a, b)
+#define _andn_v256i16(a, b)			_wv_vv(v256i16, v128i16, _andn_, a, b)
+#define _add_v256i16(a, b)			_wv_vv(v256i16, v128i16, _add_, a, b)
+#define _sub_v256i16(a, b)			_wv_vv(v256i16, v128i16, _sub_, a, b)
+#define _max_v256i16(a, b)			_wv_vv(v256i16, v128i16, _max_, a, b)
+#define _min_v256i16(a, b)			_wv_vv(v256i16, v128i16, _min_, a, b)
+#define _eq_v256i16(a, b)			_wv_vv(v256i16, v128i16, _eq_, a, b)
+#define _gt_v256i16(a, b)			_wv_vv(v256i16, v128i16, _gt_, a, b)
+#define _mask_v256i16(a)			_wv_mask(256, v256i16, v128i16, _mask_, a)
+#define _hmax_v256i16(a)			_wv_hmax(v256i16, v128i16, a)
+
+/* convert */
+#define _cvt_v128i8_v128i16(a) ({ \
+	v128i8_t _wv_tmp(0, c128w) = (a); \
+	(v128i16_t){ _cvt_v64i8_v64i16(_wv_tmp(0, c128w).lo), _cvt_v64i8_v64i16(_wv_tmp(0, c128w).hi) }; \
+})
+#define _cvt_v128i16_v128i8(a) ({ \
+	v128i16_t _wv_tmp(0, c128n) = (a); \
+	(v128i8_t){ _cvt_v64i16_v64i8(_wv_tmp(0, c128n).lo), _cvt_v64i16_v64i8(_wv_tmp(0, c128n).hi) }; \
+})
+#define _cvt_v256i8_v256i16(a) ({ \
+	v256i8_t _wv_tmp(0, c256w) = (a); \
+	(v256i16_t){ _cvt_v128i8_v128i16(_wv_tmp(0, c256w).lo), _cvt_v128i8_v128i16(_wv_tmp(0, c256w).hi) }; \
+})
+#define _cvt_v256i16_v256i8(a) ({ \
+	v256i16_t _wv_tmp(0, c256n) = (a); \
+	(v256i8_t){ _cvt_v128i16_v128i8(_wv_tmp(0, c256n).lo), _cvt_v128i16_v128i8(_wv_tmp(0, c256n).hi) }; \
+})
+
+/* debug print */
+#ifdef DEBUG
+#define _print_v128i8(a)			{ v128i8_t _wv_tmp(9, v128i8) = (a); _print_v64i8(_wv_tmp(9, v128i8).lo); _print_v64i8(_wv_tmp(9, v128i8).hi); }
+#define _print_v256i8(a)			{ v256i8_t _wv_tmp(9, v256i8) = (a); _print_v128i8(_wv_tmp(9, v256i8).lo); _print_v128i8(_wv_tmp(9, v256i8).hi); }
+#define _print_v128i16(a)			{ v128i16_t _wv_tmp(9, v128i16) = (a); _print_v64i16(_wv_tmp(9, v128i16).lo); _print_v64i16(_wv_tmp(9, v128i16).hi); }
+#define _print_v256i16(a)			{ v256i16_t _wv_tmp(9, v256i16) = (a); _print_v128i16(_wv_tmp(9, v256i16).lo); _print_v128i16(_wv_tmp(9, v256i16).hi); }
+#else
+#define _print_v128i8(x)			;
+#define _print_v256i8(x)			;
+#define _print_v128i16(x)			;
+#define _print_v256i16(x)			;
+#endif
+
+#endif /* _VECTOR_WIDE_H_INCLUDED */
+/**
+ * end of vector_wide.h
+ */
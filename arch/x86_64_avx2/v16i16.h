@@ -104,6 +104,7 @@ typedef struct v16i16_s {
 /* arithmetics */
 #define _add_v16i16(...)	_a_v16i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v16i16(...)	_a_v16i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v16i16(...)	_a_v16i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v16i16(...)	_a_v16i16(max, _e_vv, __VA_ARGS__)
 #define _min_v16i16(...)	_a_v16i16(min, _e_vv, __VA_ARGS__)
 
@@ -125,6 +126,24 @@ typedef struct v16i16_s {
 	(int16_t)_i_v16i16(extract)((a).v1, (imm)) \
 )
 
+/* shift (by one cell) */
+#define _bsl_v16i16(a, imm) ( \
+	(v16i16_t) { \
+		_mm256_alignr_epi8( \
+			(a).v1, \
+			_mm256_permute2x128_si256((a).v1, (a).v1, 0x08), \
+			14) \
+	} \
+)
+#define _bsr_v16i16(a, imm) ( \
+	(v16i16_t) { \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v1, (a).v1, 0x81), \
+			(a).v1, \
+			2) \
+	} \
+)
+
 /* mask */
 #define _mask_v16i16(a) ( \
 	(v16_mask_t) { \
@@ -134,6 +153,10 @@ typedef struct v16i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v16i16(a, b)	_mask_v16i16(_eq_v16i16((a), (b)))
+#define _mask_gt_v16i16(a, b)	_mask_v16i16(_gt_v16i16((a), (b)))
+
 /* horizontal max (reduction max) */
 #define _hmax_v16i16(a) ({ \
 	__m128i _t = _mm_max_epi16( \
@@ -88,6 +88,7 @@ typedef struct v32i16_s {
 /* arithmetics */
 #define _add_v32i16(...)	_a_v32i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v32i16(...)	_a_v32i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v32i16(...)	_a_v32i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v32i16(...)	_a_v32i16(max, _e_vv, __VA_ARGS__)
 #define _min_v32i16(...)	_a_v32i16(min, _e_vv, __VA_ARGS__)
 
@@ -109,6 +110,32 @@ typedef struct v32i16_s {
 		: _i_v32i16(extract)((a).v2, (imm) - sizeof(__m256i)/sizeof(int16_t))) \
 )
 
+/* shift (by one cell) */
+#define _bsl_v32i16(a, imm) ( \
+	(v32i16_t) { \
+		_mm256_alignr_epi8( \
+			(a).v1, \
+			_mm256_permute2x128_si256((a).v1, (a).v1, 0x08), \
+			14), \
+		_mm256_alignr_epi8( \
+			(a).v2, \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			14) \
+	} \
+)
+#define _bsr_v32i16(a, imm) ( \
+	(v32i16_t) { \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			(a).v1, \
+			2), \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v2, (a).v2, 0x81), \
+			(a).v2, \
+			2) \
+	} \
+)
+
 /* mask */
 #define _mask_v32i16(a) ( \
 	(v32_mask_t) { \
@@ -118,6 +145,10 @@ typedef struct v32i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v32i16(a, b)	_mask_v32i16(_eq_v32i16((a), (b)))
+#define _mask_gt_v32i16(a, b)	_mask_v32i16(_gt_v32i16((a), (b)))
+
 /* horizontal max (reduction max) */
 #define _hmax_v32i16(a) ({ \
 	__m256i _s = _mm256_max_epi16((a).v1, (a).v2); \
@@ -130,6 +130,17 @@ typedef struct v32i8_s {
 			1) \
 	} \
 )
+/* shift by one inside each 16-cell half (a pair of 16-cell bands packed in a vector) */
+#define _bslg_v32i8(a) ( \
+	(v32i8_t) { \
+		_mm256_slli_si256((a).v1, 1) \
+	} \
+)
+#define _bsrg_v32i8(a) ( \
+	(v32i8_t) { \
+		_mm256_srli_si256((a).v1, 1) \
+	} \
+)
 #define _shl_v32i8(a, imm) ( \
 	(v32i8_t) { \
 		_mm256_slli_epi32((a).v1, (imm)) \
@@ -151,6 +162,23 @@ typedef struct v32i8_s {
 	} \
 )
 
+/* compose and decompose 16-cell halves */
+#define _cat_v16i8_v32i8(l, h) ( \
+	(v32i8_t) { \
+		_mm256_inserti128_si256(_mm256_castsi128_si256((l).v1), (h).v1, 1) \
+	} \
+)
+#define _lo_v16i8_v32i8(a) ( \
+	(v16i8_t) { \
+		_mm256_castsi256_si128((a).v1) \
+	} \
+)
+#define _hi_v16i8_v32i8(a) ( \
+	(v16i8_t) { \
+		_mm256_extracti128_si256((a).v1, 1) \
+	} \
+)
+
 /* mask */
 #define _mask_v32i8(a) ( \
 	(v32_mask_t) { \
@@ -117,6 +117,7 @@ typedef struct v64i16_s {
 /* arithmetics */
 #define _add_v64i16(...)	_a_v64i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v64i16(...)	_a_v64i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v64i16(...)	_a_v64i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v64i16(...)	_a_v64i16(max, _e_vv, __VA_ARGS__)
 #define _min_v64i16(...)	_a_v64i16(min, _e_vv, __VA_ARGS__)
 
@@ -150,6 +151,48 @@ typedef struct v64i16_s {
 	)) \
 )
 
+/* shift (by one cell) */
+#define _bsl_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm256_alignr_epi8( \
+			(a).v1, \
+			_mm256_permute2x128_si256((a).v1, (a).v1, 0x08), \
+			14), \
+		_mm256_alignr_epi8( \
+			(a).v2, \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			14), \
+		_mm256_alignr_epi8( \
+			(a).v3, \
+			_mm256_permute2x128_si256((a).v2, (a).v3, 0x21), \
+			14), \
+		_mm256_alignr_epi8( \
+			(a).v4, \
+			_mm256_permute2x128_si256((a).v3, (a).v4, 0x21), \
+			14) \
+	} \
+)
+#define _bsr_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			(a).v1, \
+			2), \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v2, (a).v3, 0x21), \
+			(a).v2, \
+			2), \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v3, (a).v4, 0x21), \
+			(a).v3, \
+			2), \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v4, (a).v4, 0x81), \
+			(a).v4, \
+			2) \
+	} \
+)
+
 /* mask */
 #define _mask_v64i16(a) ( \
 	(v64_mask_t) { \
@@ -164,6 +207,10 @@ typedef struct v64i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v64i16(a, b)	_mask_v64i16(_eq_v64i16((a), (b)))
+#define _mask_gt_v64i16(a, b)	_mask_v64i16(_gt_v64i16((a), (b)))
+
 /* horizontal max (reduction max) */
 #define _hmax_v64i16(a) ({ \
 	__m256i _s = _mm256_max_epi16( \
@@ -164,6 +164,31 @@ typedef struct v64i8_s {
 			1) \
 	} \
 )
+/* shift by one with carry (the last byte of b is shifted into a, or the first byte of b into a); used by the 128- and 256-cell vectors */
+#define _bslc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm256_alignr_epi8( \
+			(a).v1, \
+			_mm256_permute2x128_si256((a).v1, (b).v2, 0x03), \
+			15), \
+		_mm256_alignr_epi8( \
+			(a).v2, \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			15) \
+	} \
+)
+#define _bsrc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v1, (a).v2, 0x21), \
+			(a).v1, \
+			1), \
+		_mm256_alignr_epi8( \
+			_mm256_permute2x128_si256((a).v2, (b).v1, 0x21), \
+			(a).v2, \
+			1) \
+	} \
+)
 #define _shl_v64i8(a, imm) ( \
 	(v64i8_t) { \
 		_mm256_slli_epi32((a).v1, (imm)), \
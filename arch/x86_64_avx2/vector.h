@@ -94,6 +94,14 @@ typedef union v16_mask_u v16i8_masku_t;
 #  define _mm256_broadcastsi128_si256		_mm_broadcastsi128_si256
 #endif
 
+/* compare and mask */
+#define _mask_eq_v16i8(a, b)	_mask_v16i8(_eq_v16i8(a, b))
+#define _mask_gt_v16i8(a, b)	_mask_v16i8(_gt_v16i8(a, b))
+#define _mask_eq_v32i8(a, b)	_mask_v32i8(_eq_v32i8(a, b))
+#define _mask_gt_v32i8(a, b)	_mask_v32i8(_gt_v32i8(a, b))
+#define _mask_eq_v64i8(a, b)	_mask_v64i8(_eq_v64i8(a, b))
+#define _mask_gt_v64i8(a, b)	_mask_v64i8(_gt_v64i8(a, b))
+
 /* conversion and cast between vector types */
 #define _from_v16i8_v64i8(x)	(v64i8_t){ _mm256_broadcastsi128_si256((x).v1), _mm256_broadcastsi128_si256((x).v1) }
 #define _from_v32i8_v64i8(x)	(v64i8_t){ (x).v1, (x).v1 }
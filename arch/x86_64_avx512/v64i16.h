@@ -0,0 +1,227 @@
+
+/**
+ * @file v64i16.h
+ *
+ * @brief struct and _Generic based vector class implementation
+ */
+#ifndef _V64I16_H_INCLUDED
+#define _V64I16_H_INCLUDED
+
+/* include header for intel / amd avx512 instruction sets */
+#include <x86intrin.h>
+
+/* 16bit 64cell */
+typedef struct v64i16_s {
+	__m512i v1;
+	__m512i v2;
+} v64i16_t;
+
+/* expanders (without argument) */
+#define _e_x_v64i16_1(u)
+#define _e_x_v64i16_2(u)
+
+/* expanders (without immediate) */
+#define _e_v_v64i16_1(a)				(a).v1
+#define _e_v_v64i16_2(a)				(a).v2
+#define _e_vv_v64i16_1(a, b)			(a).v1, (b).v1
+#define _e_vv_v64i16_2(a, b)			(a).v2, (b).v2
+#define _e_vvv_v64i16_1(a, b, c)		(a).v1, (b).v1, (c).v1
+#define _e_vvv_v64i16_2(a, b, c)		(a).v2, (b).v2, (c).v2
+
+/* expanders with immediate */
+#define _e_i_v64i16_1(imm)			(imm)
+#define _e_i_v64i16_2(imm)			(imm)
+#define _e_vi_v64i16_1(a, imm)		(a).v1, (imm)
+#define _e_vi_v64i16_2(a, imm)		(a).v2, (imm)
+#define _e_vvi_v64i16_1(a, b, imm)	(a).v1, (b).v1, (imm)
+#define _e_vvi_v64i16_2(a, b, imm)	(a).v2, (b).v2, (imm)
+
+/* address calculation macros */
+#define _addr_v64i16_1(imm)			( (__m512i *)(imm) )
+#define _addr_v64i16_2(imm)			( (__m512i *)(imm) + 1 )
+#define _pv_v64i16(ptr)				( _addr_v64i16_1(ptr) )
+
+/* expanders with pointers */
+#define _e_p_v64i16_1(ptr)			_addr_v64i16_1(ptr)
+#define _e_p_v64i16_2(ptr)			_addr_v64i16_2(ptr)
+#define _e_pv_v64i16_1(ptr, a)		_addr_v64i16_1(ptr), (a).v1
+#define _e_pv_v64i16_2(ptr, a)		_addr_v64i16_2(ptr), (a).v2
+
+/* expand intrinsic name */
+#define _i_v64i16(intrin) 			_mm512_##intrin##_epi16
+#define _i_v64i16x(intrin)			_mm512_##intrin##_si512
+
+/* apply */
+#define _a_v64i16(intrin, expander, ...) ( \
+	(v64i16_t) { \
+		_i_v64i16(intrin)(expander##_v64i16_1(__VA_ARGS__)), \
+		_i_v64i16(intrin)(expander##_v64i16_2(__VA_ARGS__)) \
+	} \
+)
+#define _a_v64i16x(intrin, expander, ...) ( \
+	(v64i16_t) { \
+		_i_v64i16x(intrin)(expander##_v64i16_1(__VA_ARGS__)), \
+		_i_v64i16x(intrin)(expander##_v64i16_2(__VA_ARGS__)) \
+	} \
+)
+#define _a_v64i16xv(intrin, expander, ...) { \
+	_i_v64i16x(intrin)(expander##_v64i16_1(__VA_ARGS__)); \
+	_i_v64i16x(intrin)(expander##_v64i16_2(__VA_ARGS__)); \
+}
+
+/* load and store (blocks are aligned only to 32-byte boundaries; aligned-only forms are not used) */
+#define _load_v64i16(...)	_a_v64i16x(loadu, _e_p, __VA_ARGS__)
+#define _loadu_v64i16(...)	_a_v64i16x(loadu, _e_p, __VA_ARGS__)
+#define _store_v64i16(...)	_a_v64i16xv(storeu, _e_pv, __VA_ARGS__)
+#define _storeu_v64i16(...)	_a_v64i16xv(storeu, _e_pv, __VA_ARGS__)
+
+/* broadcast */
+#define _set_v64i16(...)	_a_v64i16(set1, _e_i, __VA_ARGS__)
+#define _zero_v64i16()		_a_v64i16x(setzero, _e_x, _unused)
+
+/* logics */
+#define _and_v64i16(...)	_a_v64i16x(and, _e_vv, __VA_ARGS__)
+#define _or_v64i16(...)		_a_v64i16x(or, _e_vv, __VA_ARGS__)
+#define _xor_v64i16(...)	_a_v64i16x(xor, _e_vv, __VA_ARGS__)
+#define _andn_v64i16(...)	_a_v64i16x(andnot, _e_vv, __VA_ARGS__)
+
+/* arithmetics */
+#define _add_v64i16(...)	_a_v64i16(add, _e_vv, __VA_ARGS__)
+#define _sub_v64i16(...)	_a_v64i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v64i16(...)	_a_v64i16(subs, _e_vv, __VA_ARGS__)
+#define _max_v64i16(...)	_a_v64i16(max, _e_vv, __VA_ARGS__)
+#define _min_v64i16(...)	_a_v64i16(min, _e_vv, __VA_ARGS__)
+
+/* compare (k-register results are expanded to vectors) */
+#define _eq_v64i16(a, b) ( \
+	(v64i16_t) { \
+		_mm512_movm_epi16(_mm512_cmpeq_epi16_mask((a).v1, (b).v1)), \
+		_mm512_movm_epi16(_mm512_cmpeq_epi16_mask((a).v2, (b).v2)) \
+	} \
+)
+#define _gt_v64i16(a, b) ( \
+	(v64i16_t) { \
+		_mm512_movm_epi16(_mm512_cmpgt_epi16_mask((a).v1, (b).v1)), \
+		_mm512_movm_epi16(_mm512_cmpgt_epi16_mask((a).v2, (b).v2)) \
+	} \
+)
+
+/* insert and extract */
+#define _V64I16_N			( sizeof(__m128i) / sizeof(int16_t) )
+#define _ins_v64i16(a, val, imm) { \
+	if((imm) < 4 * _V64I16_N) { \
+		(a).v1 = _mm512_inserti32x4((a).v1, \
+			_mm_insert_epi16(_mm512_extracti32x4_epi32((a).v1, ((imm)>>3) & 0x03), (val), (imm) & 0x07), \
+			((imm)>>3) & 0x03); \
+	} else { \
+		(a).v2 = _mm512_inserti32x4((a).v2, \
+			_mm_insert_epi16(_mm512_extracti32x4_epi32((a).v2, ((imm)>>3) & 0x03), (val), (imm) & 0x07), \
+			((imm)>>3) & 0x03); \
+	} \
+}
+#define _ext_v64i16(a, imm) ( \
+	(int16_t)(((imm) < 4 * _V64I16_N) ? ( \
+		_mm_extract_epi16(_mm512_extracti32x4_epi32((a).v1, ((imm)>>3) & 0x03), (imm) & 0x07) \
+	) : ( \
+		_mm_extract_epi16(_mm512_extracti32x4_epi32((a).v2, ((imm)>>3) & 0x03), (imm) & 0x07) \
+	)) \
+)
+
+/* shift (by one cell) */
+#define _bsl_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm512_alignr_epi8( \
+			(a).v1, \
+			_mm512_alignr_epi64((a).v1, _mm512_setzero_si512(), 6), \
+			14), \
+		_mm512_alignr_epi8( \
+			(a).v2, \
+			_mm512_alignr_epi64((a).v2, (a).v1, 6), \
+			14) \
+	} \
+)
+#define _bsr_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm512_alignr_epi8( \
+			_mm512_alignr_epi64((a).v2, (a).v1, 2), \
+			(a).v1, \
+			2), \
+		_mm512_alignr_epi8( \
+			_mm512_alignr_epi64(_mm512_setzero_si512(), (a).v2, 2), \
+			(a).v2, \
+			2) \
+	} \
+)
+
+/* mask */
+#define _mask_v64i16(a) ( \
+	(v64_mask_t) { \
+		.m1 = ((uint64_t)_mm512_movepi16_mask((a).v1)) \
+			| ((uint64_t)_mm512_movepi16_mask((a).v2)<<32) \
+	} \
+)
+
+/* compare and mask (issues k-register compares directly) */
+#define _mask_eq_v64i16(a, b) ( \
+	(v64_mask_t) { \
+		.m1 = ((uint64_t)_mm512_cmpeq_epi16_mask((a).v1, (b).v1)) \
+			| ((uint64_t)_mm512_cmpeq_epi16_mask((a).v2, (b).v2)<<32) \
+	} \
+)
+#define _mask_gt_v64i16(a, b) ( \
+	(v64_mask_t) { \
+		.m1 = ((uint64_t)_mm512_cmpgt_epi16_mask((a).v1, (b).v1)) \
+			| ((uint64_t)_mm512_cmpgt_epi16_mask((a).v2, (b).v2)<<32) \
+	} \
+)
+
+/* horizontal max (reduction max) */
+#define _hmax_v64i16(a) ({ \
+	__m512i _s = _mm512_max_epi16((a).v1, (a).v2); \
+	__m256i _u = _mm256_max_epi16( \
+		_mm512_castsi512_si256(_s), \
+		_mm512_extracti64x4_epi64(_s, 1) \
+	); \
+	__m128i _t = _mm_max_epi16( \
+		_mm256_castsi256_si128(_u), \
+		_mm256_extracti128_si256(_u, 1) \
+	); \
+	_t = _mm_max_epi16(_t, _mm_srli_si128(_t, 8)); \
+	_t = _mm_max_epi16(_t, _mm_srli_si128(_t, 4)); \
+	_t = _mm_max_epi16(_t, _mm_srli_si128(_t, 2)); \
+	(int16_t)_mm_extract_epi16(_t, 0); \
+})
+
+#define _cvt_v64i8_v64i16(a) ( \
+	(v64i16_t) { \
+		_mm512_cvtepi8_epi16(_mm512_castsi512_si256((a).v1)), \
+		_mm512_cvtepi8_epi16(_mm512_extracti64x4_epi64((a).v1, 1)) \
+	} \
+)
+
+/* debug print */
+#ifdef DEBUG
+#define _print_v64i16(a) { \
+	int16_t _tmp[64]; v64i16_t _tmpv = (a); _storeu_v64i16(_tmp, _tmpv); \
+	debug("(v64i16_t) %s(%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+			"%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+			"%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+			"%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d)", \
+		#a, \
+		_tmp[63], _tmp[62], _tmp[61], _tmp[60], _tmp[59], _tmp[58], _tmp[57], _tmp[56], \
+		_tmp[55], _tmp[54], _tmp[53], _tmp[52], _tmp[51], _tmp[50], _tmp[49], _tmp[48], \
+		_tmp[47], _tmp[46], _tmp[45], _tmp[44], _tmp[43], _tmp[42], _tmp[41], _tmp[40], \
+		_tmp[39], _tmp[38], _tmp[37], _tmp[36], _tmp[35], _tmp[34], _tmp[33], _tmp[32], \
+		_tmp[31], _tmp[30], _tmp[29], _tmp[28], _tmp[27], _tmp[26], _tmp[25], _tmp[24], \
+		_tmp[23], _tmp[22], _tmp[21], _tmp[20], _tmp[19], _tmp[18], _tmp[17], _tmp[16], \
+		_tmp[15], _tmp[14], _tmp[13], _tmp[12], _tmp[11], _tmp[10], _tmp[9], _tmp[8], \
+		_tmp[7], _tmp[6], _tmp[5], _tmp[4], _tmp[3], _tmp[2], _tmp[1], _tmp[0]); \
+}
+#else
+#define _print_v64i16(x)	;
+#endif
+
+#endif /* _V64I16_H_INCLUDED */
+/**
+ * end of v64i16.h
+ */
@@ -0,0 +1,243 @@
+
+/**
+ * @file v64i8.h
+ *
+ * @brief struct and _Generic based vector class implementation
+ */
+#ifndef _V64I8_H_INCLUDED
+#define _V64I8_H_INCLUDED
+
+/* include header for intel / amd avx512 instruction sets */
+#include <x86intrin.h>
+
+/* 8bit 64cell */
+typedef struct v64i8_s {
+	__m512i v1;
+} v64i8_t;
+
+/* expanders (without argument) */
+#define _e_x_v64i8_1(u)
+
+/* expanders (without immediate) */
+#define _e_v_v64i8_1(a)				(a).v1
+#define _e_vv_v64i8_1(a, b)			(a).v1, (b).v1
+#define _e_vvv_v64i8_1(a, b, c)		(a).v1, (b).v1, (c).v1
+
+/* expanders with immediate */
+#define _e_i_v64i8_1(imm)			(imm)
+#define _e_vi_v64i8_1(a, imm)		(a).v1, (imm)
+#define _e_vvi_v64i8_1(a, b, imm)	(a).v1, (b).v1, (imm)
+
+/* address calculation macros */
+#define _addr_v64i8_1(imm)			( (__m512i *)(imm) )
+#define _pv_v64i8(ptr)				( _addr_v64i8_1(ptr) )
+
+/* expanders with pointers */
+#define _e_p_v64i8_1(ptr)			_addr_v64i8_1(ptr)
+#define _e_pv_v64i8_1(ptr, a)		_addr_v64i8_1(ptr), (a).v1
+
+/* expand intrinsic name */
+#define _i_v64i8(intrin) 			_mm512_##intrin##_epi8
+#define _i_v64i8x(intrin)			_mm512_##intrin##_si512
+
+/* apply */
+#define _a_v64i8(intrin, expander, ...) ( \
+	(v64i8_t) { \
+		_i_v64i8(intrin)(expander##_v64i8_1(__VA_ARGS__)) \
+	} \
+)
+#define _a_v64i8x(intrin, expander, ...) ( \
+	(v64i8_t) { \
+		_i_v64i8x(intrin)(expander##_v64i8_1(__VA_ARGS__)) \
+	} \
+)
+#define _a_v64i8xv(intrin, expander, ...) { \
+	_i_v64i8x(intrin)(expander##_v64i8_1(__VA_ARGS__)); \
+}
+
+/* load and store (blocks are aligned only to 32-byte boundaries; aligned-only forms are not used) */
+#define _load_v64i8(...)	_a_v64i8x(loadu, _e_p, __VA_ARGS__)
+#define _loadu_v64i8(...)	_a_v64i8x(loadu, _e_p, __VA_ARGS__)
+#define _store_v64i8(...)	_a_v64i8xv(storeu, _e_pv, __VA_ARGS__)
+#define _storeu_v64i8(...)	_a_v64i8xv(storeu, _e_pv, __VA_ARGS__)
+
+/* broadcast */
+#define _set_v64i8(...)		_a_v64i8(set1, _e_i, __VA_ARGS__)
+#define _zero_v64i8()		_a_v64i8x(setzero, _e_x, _unused)
+
+/* swap (reverse) */
+#define _swap_idx_v64i8() ( \
+	_mm512_broadcast_i32x4(_mm_set_epi8( \
+		0, 1, 2, 3, 4, 5, 6, 7, \
+		8, 9, 10, 11, 12, 13, 14, 15)) \
+)
+#define _swap_v64i8(a) ( \
+	(v64i8_t) { \
+		_mm512_shuffle_i64x2( \
+			_mm512_shuffle_epi8((a).v1, _swap_idx_v64i8()), \
+			_mm512_shuffle_epi8((a).v1, _swap_idx_v64i8()), \
+			0x1b) \
+	} \
+)
+
+/* logics */
+#define _not_v64i8(a) ( \
+	(v64i8_t) { \
+		_mm512_ternarylogic_epi32((a).v1, (a).v1, (a).v1, 0x55) \
+	} \
+)
+#define _and_v64i8(...)		_a_v64i8x(and, _e_vv, __VA_ARGS__)
+#define _or_v64i8(...)		_a_v64i8x(or, _e_vv, __VA_ARGS__)
+#define _xor_v64i8(...)		_a_v64i8x(xor, _e_vv, __VA_ARGS__)
+#define _andn_v64i8(...)	_a_v64i8x(andnot, _e_vv, __VA_ARGS__)
+
+/* arithmetics */
+#define _add_v64i8(...)		_a_v64i8(add, _e_vv, __VA_ARGS__)
+#define _sub_v64i8(...)		_a_v64i8(sub, _e_vv, __VA_ARGS__)
+#define _adds_v64i8(...)	_a_v64i8(adds, _e_vv, __VA_ARGS__)
+#define _subs_v64i8(...)	_a_v64i8(subs, _e_vv, __VA_ARGS__)
+#define _max_v64i8(...)		_a_v64i8(max, _e_vv, __VA_ARGS__)
+#define _min_v64i8(...)		_a_v64i8(min, _e_vv, __VA_ARGS__)
+
+/* shuffle */
+#define _shuf_v64i8(...)	_a_v64i8(shuffle, _e_vv, __VA_ARGS__)
+
+/* blend (the selector is a vector, converted to a k-register) */
+#define _sel_v64i8(a, b, mask) ( \
+	(v64i8_t) { \
+		_mm512_mask_blend_epi8(_mm512_movepi8_mask((mask).v1), (a).v1, (b).v1) \
+	} \
+)
+
+/* compare (k-register results are expanded to vectors) */
+#define _eq_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm512_movm_epi8(_mm512_cmpeq_epi8_mask((a).v1, (b).v1)) \
+	} \
+)
+#define _gt_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm512_movm_epi8(_mm512_cmpgt_epi8_mask((a).v1, (b).v1)) \
+	} \
+)
+
+/* insert and extract */
+#define _ins_v64i8(a, val, imm) { \
+	(a).v1 = _mm512_inserti32x4((a).v1, \
+		_mm_insert_epi8(_mm512_extracti32x4_epi32((a).v1, (imm)>>4), (val), (imm) & 0x0f), \
+		(imm)>>4); \
+}
+#define _ext_v64i8(a, imm) ( \
+	(int8_t)_mm_extract_epi8(_mm512_extracti32x4_epi32((a).v1, (imm)>>4), (imm) & 0x0f) \
+)
+
+/* shift */
+#define _bsl_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_alignr_epi8( \
+			(a).v1, \
+			_mm512_alignr_epi64((a).v1, _mm512_setzero_si512(), 6), \
+			15) \
+	} \
+)
+#define _bsr_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_alignr_epi8( \
+			_mm512_alignr_epi64(_mm512_setzero_si512(), (a).v1, 2), \
+			(a).v1, \
+			1) \
+	} \
+)
+/* shift by one with carry (the last byte of b is shifted into a, or the first byte of b into a); used by the 128- and 256-cell vectors */
+#define _bslc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm512_alignr_epi8( \
+			(a).v1, \
+			_mm512_alignr_epi64((a).v1, (b).v1, 6), \
+			15) \
+	} \
+)
+#define _bsrc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_mm512_alignr_epi8( \
+			_mm512_alignr_epi64((b).v1, (a).v1, 2), \
+			(a).v1, \
+			1) \
+	} \
+)
+#define _shl_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_slli_epi32((a).v1, (imm)) \
+	} \
+)
+#define _shr_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_srli_epi32((a).v1, (imm)) \
+	} \
+)
+#define _sal_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_slli_epi32((a).v1, (imm)) \
+	} \
+)
+#define _sar_v64i8(a, imm) ( \
+	(v64i8_t) { \
+		_mm512_srai_epi32((a).v1, (imm)) \
+	} \
+)
+
+/* mask */
+#define _mask_v64i8(a) ( \
+	(v64_mask_t) { \
+		.m1 = _mm512_movepi8_mask((a).v1) \
+	} \
+)
+
+/* compare and mask (issues k-register compares directly) */
+#define _mask_eq_v64i8(a, b) ( \
+	(v64_mask_t) { \
+		.m1 = _mm512_cmpeq_epi8_mask((a).v1, (b).v1) \
+	} \
+)
+#define _mask_gt_v64i8(a, b) ( \
+	(v64_mask_t) { \
+		.m1 = _mm512_cmpgt_epi8_mask((a).v1, (b).v1) \
+	} \
+)
+
+/* convert */
+#define _cvt_v64i16_v64i8(a) ( \
+	(v64i8_t) { \
+		_mm512_inserti64x4( \
+			_mm512_castsi256_si512(_mm512_cvtsepi16_epi8((a).v1)), \
+			_mm512_cvtsepi16_epi8((a).v2), \
+			1) \
+	} \
+)
+
+/* debug print */
+#ifdef DEBUG
+#define _print_v64i8(a) { \
+	int8_t _tmp[64]; v64i8_t _tmpv = (a); _storeu_v64i8(_tmp, _tmpv); \
+	debug("(v64i8_t) %s(%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+				 "%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+				 "%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, " \
+				 "%d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d, %d)", \
+		#a, \
+		_tmp[63], _tmp[62], _tmp[61], _tmp[60], _tmp[59], _tmp[58], _tmp[57], _tmp[56], \
+		_tmp[55], _tmp[54], _tmp[53], _tmp[52], _tmp[51], _tmp[50], _tmp[49], _tmp[48], \
+		_tmp[47], _tmp[46], _tmp[45], _tmp[44], _tmp[43], _tmp[42], _tmp[41], _tmp[40], \
+		_tmp[39], _tmp[38], _tmp[37], _tmp[36], _tmp[35], _tmp[34], _tmp[33], _tmp[32], \
+		_tmp[31], _tmp[30], _tmp[29], _tmp[28], _tmp[27], _tmp[26], _tmp[25], _tmp[24], \
+		_tmp[23], _tmp[22], _tmp[21], _tmp[20], _tmp[19], _tmp[18], _tmp[17], _tmp[16], \
+		_tmp[15], _tmp[14], _tmp[13], _tmp[12], _tmp[11], _tmp[10], _tmp[9], _tmp[8], \
+		_tmp[7], _tmp[6], _tmp[5], _tmp[4], _tmp[3], _tmp[2], _tmp[1], _tmp[0]); \
+}
+#else
+#define _print_v64i8(x)		;
+#endif
+
+#endif /* _V64I8_H_INCLUDED */
+/**
+ * end of v64i8.h
+ */
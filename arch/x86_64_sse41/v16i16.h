@@ -106,6 +106,7 @@ typedef struct v16i16_s {
 /* arithmetics */
 #define _add_v16i16(...)	_a_v16i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v16i16(...)	_a_v16i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v16i16(...)	_a_v16i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v16i16(...)	_a_v16i16(max, _e_vv, __VA_ARGS__)
 #define _min_v16i16(...)	_a_v16i16(min, _e_vv, __VA_ARGS__)
 
@@ -133,6 +134,20 @@ typedef struct v16i16_s {
 		: _i_v16i16(extract)((a).v2, (imm) - sizeof(__m128i)/sizeof(int16_t))) \
 )
 
+/* shift (in cells; imm must be smaller than 8) */
+#define _bsl_v16i16(a, imm) ( \
+	(v16i16_t) { \
+		_mm_slli_si128((a).v1, 2 * (imm)), \
+		_mm_alignr_epi8((a).v2, (a).v1, sizeof(__m128i) - 2 * (imm)) \
+	} \
+)
+#define _bsr_v16i16(a, imm) ( \
+	(v16i16_t) { \
+		_mm_alignr_epi8((a).v2, (a).v1, 2 * (imm)), \
+		_mm_srli_si128((a).v2, 2 * (imm)) \
+	} \
+)
+
 /* mask */
 #define _mask_v16i16(a) ( \
 	(v16_mask_t) { \
@@ -141,6 +156,10 @@ typedef struct v16i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v16i16(a, b)	_mask_v16i16(_eq_v16i16((a), (b)))
+#define _mask_gt_v16i16(a, b)	_mask_v16i16(_gt_v16i16((a), (b)))
+
 /* horizontal max */
 #define _hmax_v16i16(a) ({ \
 	__m128i _vmax = _mm_max_epi16((a).v1, (a).v2); \
@@ -116,6 +116,7 @@ typedef struct v32i16_s {
 /* arithmetics */
 #define _add_v32i16(...)	_a_v32i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v32i16(...)	_a_v32i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v32i16(...)	_a_v32i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v32i16(...)	_a_v32i16(max, _e_vv, __VA_ARGS__)
 #define _min_v32i16(...)	_a_v32i16(min, _e_vv, __VA_ARGS__)
 
@@ -145,6 +146,24 @@ typedef struct v32i16_s {
 		: _i_v32i16(extract)((a).v4, (imm) - 3*sizeof(__m128i)/sizeof(int16_t))))) \
 )
 
+/* shift (in cells; imm must be smaller than 8) */
+#define _bsl_v32i16(a, imm) ( \
+	(v32i16_t) { \
+		_mm_slli_si128((a).v1, 2 * (imm)), \
+		_mm_alignr_epi8((a).v2, (a).v1, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v3, (a).v2, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v4, (a).v3, sizeof(__m128i) - 2 * (imm)) \
+	} \
+)
+#define _bsr_v32i16(a, imm) ( \
+	(v32i16_t) { \
+		_mm_alignr_epi8((a).v2, (a).v1, 2 * (imm)), \
+		_mm_alignr_epi8((a).v3, (a).v2, 2 * (imm)), \
+		_mm_alignr_epi8((a).v4, (a).v3, 2 * (imm)), \
+		_mm_srli_si128((a).v4, 2 * (imm)) \
+	} \
+)
+
 /* mask */
 #define _mask_v32i16(a) ( \
 	(v32_mask_t) { \
@@ -155,6 +174,10 @@ typedef struct v32i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v32i16(a, b)	_mask_v32i16(_eq_v32i16((a), (b)))
+#define _mask_gt_v32i16(a, b)	_mask_v32i16(_gt_v32i16((a), (b)))
+
 /* horizontal max (reduction max) */
 #define _hmax_v32i16(a) ({ \
 	__m128i _vmax = _mm_max_epi16( \
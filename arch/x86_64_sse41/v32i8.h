@@ -145,6 +145,19 @@ typedef struct v32i8_s {
 		_i_v32i8x(srli)((a).v2, (imm)) \
 	} \
 )
+/* shift by one inside each 16-cell half (a pair of 16-cell bands packed in a vector) */
+#define _bslg_v32i8(a) ( \
+	(v32i8_t) { \
+		_i_v32i8x(slli)((a).v1, 1), \
+		_i_v32i8x(slli)((a).v2, 1) \
+	} \
+)
+#define _bsrg_v32i8(a) ( \
+	(v32i8_t) { \
+		_i_v32i8x(srli)((a).v1, 1), \
+		_i_v32i8x(srli)((a).v2, 1) \
+	} \
+)
 #define _shl_v32i8(a, imm) ( \
 	(v32i8_t) { \
 		_mm_slli_epi32((a).v1, (imm)), \
@@ -170,6 +183,11 @@ typedef struct v32i8_s {
 	} \
 )
 
+/* compose and decompose 16-cell halves */
+#define _cat_v16i8_v32i8(l, h)		( (v32i8_t){ (l).v1, (h).v1 } )
+#define _lo_v16i8_v32i8(a)			( (v16i8_t){ (a).v1 } )
+#define _hi_v16i8_v32i8(a)			( (v16i8_t){ (a).v2 } )
+
 /* mask */
 #define _mask_v32i8(a) ( \
 	(v32_mask_t) { \
@@ -173,6 +173,7 @@ typedef struct v64i16_s {
 /* arithmetics */
 #define _add_v64i16(...)	_a_v64i16(add, _e_vv, __VA_ARGS__)
 #define _sub_v64i16(...)	_a_v64i16(sub, _e_vv, __VA_ARGS__)
+#define _subs_v64i16(...)	_a_v64i16(subs, _e_vv, __VA_ARGS__)
 #define _max_v64i16(...)	_a_v64i16(max, _e_vv, __VA_ARGS__)
 #define _min_v64i16(...)	_a_v64i16(min, _e_vv, __VA_ARGS__)
 
@@ -221,6 +222,32 @@ typedef struct v64i16_s {
 	)) \
 )
 
+/* shift (in cells; imm must be smaller than 8) */
+#define _bsl_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm_slli_si128((a).v1, 2 * (imm)), \
+		_mm_alignr_epi8((a).v2, (a).v1, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v3, (a).v2, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v4, (a).v3, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v5, (a).v4, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v6, (a).v5, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v7, (a).v6, sizeof(__m128i) - 2 * (imm)), \
+		_mm_alignr_epi8((a).v8, (a).v7, sizeof(__m128i) - 2 * (imm)) \
+	} \
+)
+#define _bsr_v64i16(a, imm) ( \
+	(v64i16_t) { \
+		_mm_alignr_epi8((a).v2, (a).v1, 2 * (imm)), \
+		_mm_alignr_epi8((a).v3, (a).v2, 2 * (imm)), \
+		_mm_alignr_epi8((a).v4, (a).v3, 2 * (imm)), \
+		_mm_alignr_epi8((a).v5, (a).v4, 2 * (imm)), \
+		_mm_alignr_epi8((a).v6, (a).v5, 2 * (imm)), \
+		_mm_alignr_epi8((a).v7, (a).v6, 2 * (imm)), \
+		_mm_alignr_epi8((a).v8, (a).v7, 2 * (imm)), \
+		_mm_srli_si128((a).v8, 2 * (imm)) \
+	} \
+)
+
 /* mask */
 #define _mask_v64i16(a) ( \
 	(v64_mask_t) { \
@@ -231,6 +258,10 @@ typedef struct v64i16_s {
 	} \
 )
 
+/* compare and mask */
+#define _mask_eq_v64i16(a, b)	_mask_v64i16(_eq_v64i16((a), (b)))
+#define _mask_gt_v64i16(a, b)	_mask_v64i16(_gt_v64i16((a), (b)))
+
 /* horizontal max (reduction max) */
 #define _hmax_v64i16(a) ({ \
 	__m128i _vmax = _mm_max_epi16( \
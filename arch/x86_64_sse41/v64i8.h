@@ -188,6 +188,23 @@ typedef struct v64i8_s {
 		_i_v64i8x(srli)((a).v4, (imm)) \
 	} \
 )
+/* shift by one with carry (the last byte of b is shifted into a, or the first byte of b into a); used by the 128- and 256-cell vectors */
+#define _bslc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_i_v64i8(alignr)((a).v1, (b).v4, sizeof(__m128i) - 1), \
+		_i_v64i8(alignr)((a).v2, (a).v1, sizeof(__m128i) - 1), \
+		_i_v64i8(alignr)((a).v3, (a).v2, sizeof(__m128i) - 1), \
+		_i_v64i8(alignr)((a).v4, (a).v3, sizeof(__m128i) - 1) \
+	} \
+)
+#define _bsrc_v64i8(a, b) ( \
+	(v64i8_t) { \
+		_i_v64i8(alignr)((a).v2, (a).v1, 1), \
+		_i_v64i8(alignr)((a).v3, (a).v2, 1), \
+		_i_v64i8(alignr)((a).v4, (a).v3, 1), \
+		_i_v64i8(alignr)((b).v1, (a).v4, 1) \
+	} \
+)
 #define _shl_v64i8(a, imm) ( \
 	(v64i8_t) { \
 		_mm_slli_epi32((a).v1, (imm)), \
@@ -93,6 +93,14 @@ typedef union v16_mask_u v16i8_masku_t;
 #include "v64i8.h"
 #include "v64i16.h"
 
+/* compare and mask */
+#define _mask_eq_v16i8(a, b)	_mask_v16i8(_eq_v16i8(a, b))
+#define _mask_gt_v16i8(a, b)	_mask_v16i8(_gt_v16i8(a, b))
+#define _mask_eq_v32i8(a, b)	_mask_v32i8(_eq_v32i8(a, b))
+#define _mask_gt_v32i8(a, b)	_mask_v32i8(_gt_v32i8(a, b))
+#define _mask_eq_v64i8(a, b)	_mask_v64i8(_eq_v64i8(a, b))
+#define _mask_gt_v64i8(a, b)	_mask_v64i8(_gt_v64i8(a, b))
+
 /* conversion and cast between vector types */
 #define _from_v16i8_v64i8(x)	(v64i8_t){ (x).v1, (x).v1, (x).v1, (x).v1 }
 #define _from_v32i8_v64i8(x)	(v64i8_t){ (x).v1, (x).v2, (x).v1, (x).v2 }
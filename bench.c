@@ -18,7 +18,11 @@
  */
 void print_usage(void)
 {
-	fprintf(stderr, "usage: bench -l <len> -c <cnt> -x <mismatch rate> -d <indel rate>\n");
+	fprintf(stderr, "usage: bench -l <len> -c <cnt> -x <mismatch rate> -d <indel rate> -w <drift> [-p] [-s <steer>] [-e]\n");
+	fprintf(stderr, "  -w : bound of the drift of the alignment path from the diagonal in the generated pairs (8 by default)\n");
+	fprintf(stderr, "  -p : fill the extensions two at a time with gaba_dp_fill_root_batch (dual-stream kernel)\n");
+	fprintf(stderr, "  -s : steering policy of the band, 0: edge (default), 1: max, 2: anchor, 3: damped\n");
+	fprintf(stderr, "  -e : fill <cnt> fresh pairs and print the fill time and the band escapes per 1000 alignments\n");
 }
 
 /**
@@ -118,6 +122,10 @@ struct params {
 	int64_t cnt;
 	double x;
 	double d;
+	int64_t pair;
+	int64_t wave;
+	int64_t steer;
+	int64_t escape;
 	char **pa;
 	char **pb;
 };
@@ -134,11 +142,15 @@ int parse_args(struct params *p, int c, char *arg)
 		case 'l': p->len = atoi((char *)arg); return 0;
 		case 'x': p->x = atof((char *)arg); return 0;
 		case 'd': p->d = atof((char *)arg); return 0;
+		case 'w': p->wave = atoi((char *)arg); return 0;
 		/**
 		 * benchmarking options
 		 */
 		case 'c': p->cnt = atoi((char *)arg); return 0;
 		case 'a': printf("%s\n", arg); return 0;
+		case 'p': p->pair = 1; return 0;
+		case 's': p->steer = atoi((char *)arg); return 0;
+		case 'e': p->escape = 1; return 0;
 		/**
 		 * the others: print help message
 		 */
@@ -147,47 +159,100 @@ int parse_args(struct params *p, int c, char *arg)
 	}
 }
 
+/**
+ * @fn bench_escape
+ * @brief fill fresh pairs one by one; the path of the generated pair reaches the ends, so an
+ * extension terminated by X-drop before reaching either end lost the path out of the band (band escape)
+ */
+int bench_escape(gaba_t *ctx, struct params const *p)
+{
+	bench_t fill;
+	bench_init(fill);
+
+	int64_t escape = 0;
+	for(int64_t i = 0; i < p->cnt; i++) {
+		char *a = add_margin(generate_random_sequence(p->len));
+		char *b = add_margin(generate_mutated_sequence(a, p->len, p->x, p->d, p->wave));
+		struct gaba_section_s asec = gaba_build_section(0, (uint8_t const *)a, strlen(a));
+		struct gaba_section_s bsec = gaba_build_section(2, (uint8_t const *)b, strlen(b));
+
+		gaba_dp_t *dp = gaba_dp_init(ctx);
+		gaba_dp_set_anchor(dp, 0);		/* the path starts on the diagonal of the root */
+
+		bench_start(fill);
+		struct gaba_fill_s const *f = gaba_dp_fill_root(dp, &asec, 0, &bsec, 0, 0);
+		bench_end(fill);
+		escape += (f->status & GABA_TERM) != 0 && (f->status & (GABA_UPDATE_A | GABA_UPDATE_B)) == 0;
+
+		gaba_dp_clean(dp);
+		free(remove_margin(a));
+		free(remove_margin(b));
+	}
+
+	printf("%" PRId64 "\t%.1f\n", bench_get(fill), 1000.0 * (double)escape / (double)p->cnt);
+	return(0);
+}
+
 /**
  * @fn main
  */
 int main(int argc, char *argv[])
 {
 	int64_t i;
-	char *a;
-	char *b;
+	char *a[2];
+	char *b[2];
 	char *c;
 	struct params p;
-	bench_t fill, trace, parse;
+	bench_t fill, search, trace, parse;
 
 	/** set defaults */
 	p.len = 10000;
 	p.cnt = 10000;
 	p.x = 0.1;
 	p.d = 0.1;
+	p.pair = 0;
+	p.wave = 8;
+	p.steer = GABA_STEER_EDGE;
+	p.escape = 0;
 	p.pa = p.pb = NULL;
 
 	/** parse args */
-	while((i = getopt(argc, argv, "q:t:o:l:x:d:c:a:seb:h")) != -1) {
+	while((i = getopt(argc, argv, "q:t:o:l:x:d:w:c:a:s:eb:ph")) != -1) {
 		if(parse_args(&p, i, optarg) != 0) { exit(1); }
 	}
 
-	fprintf(stderr, "len\t%" PRId64 "\ncnt\t%" PRId64 "\nx\t%f\nd\t%f\n", p.len, p.cnt, p.x, p.d);
-
-	/** init sequence */
-	a = add_margin(generate_random_sequence(p.len));
-	b = add_margin(generate_mutated_sequence(a, p.len, p.x, p.d, 8));
-
-	/* init cigar string buffer */
-	c = (char *)malloc(p.len);
+	fprintf(stderr, "len\t%" PRId64 "\ncnt\t%" PRId64 "\nx\t%f\nd\t%f\npair\t%" PRId64 "\nsteer\t%" PRId64 "\n", p.len, p.cnt, p.x, p.d, p.pair, p.steer);
 
 	/** init context */
 	gaba_t *ctx = gaba_init(GABA_PARAMS(
 		.xdrop = 100,
+		.steer = p.steer,
 		GABA_SCORE_SIMPLE(2, 3, 5, 1)));
-	struct gaba_section_s asec = gaba_build_section(0, (uint8_t const *)a, strlen(a));
-	struct gaba_section_s bsec = gaba_build_section(2, (uint8_t const *)b, strlen(b));
+	if(p.escape) {
+		bench_escape(ctx, &p);
+		gaba_clean(ctx);
+		return 0;
+	}
+
+	/** init sequences; two pairs are filled alternately (or together in the pair mode) */
+	for(i = 0; i < 2; i++) {
+		a[i] = add_margin(generate_random_sequence(p.len));
+		b[i] = add_margin(generate_mutated_sequence(a[i], p.len, p.x, p.d, p.wave));
+	}
+
+	/* init cigar string buffer */
+	c = (char *)malloc(p.len);
+
+	struct gaba_section_s asec[2], bsec[2];
+	struct gaba_seed_s seed[2];
+	for(i = 0; i < 2; i++) {
+		asec[i] = gaba_build_section(4 * i, (uint8_t const *)a[i], strlen(a[i]));
+		bsec[i] = gaba_build_section(4 * i + 2, (uint8_t const *)b[i], strlen(b[i]));
+		seed[i] = (struct gaba_seed_s){ .a = &asec[i], .b = &bsec[i] };
+	}
 
 	bench_init(fill);
+	bench_init(search);
 	bench_init(trace);
 	bench_init(parse);
 
@@ -195,41 +260,56 @@ int main(int argc, char *argv[])
 	 * run benchmark.
 	 */
 	int64_t score = 0;
-	for(i = 0; i < p.cnt; i++) {
+	for(i = 0; i < p.cnt; i += 2) {
 
 		gaba_dp_t *dp = gaba_dp_init(ctx);
 
 		bench_start(fill);
-		struct gaba_fill_s *f = gaba_dp_fill_root(dp, &asec, 0, &bsec, 0, 0);
-		score += f->max;
+		struct gaba_fill_s const *f[2];
+		if(p.pair) {
+			gaba_dp_fill_root_batch(dp, seed, 2, 0, f);
+		} else {
+			f[0] = gaba_dp_fill_root(dp, &asec[0], 0, &bsec[0], 0, 0);
+			f[1] = gaba_dp_fill_root(dp, &asec[1], 0, &bsec[1], 0, 0);
+		}
+		score += f[0]->max + f[1]->max;
 		bench_end(fill);
-		
-		bench_start(trace);
-		struct gaba_alignment_s *r = gaba_dp_trace(dp, f, NULL);
-		bench_end(trace);
 
-		bench_start(parse);
-		gaba_dump_cigar_forward(c, p.len, r->path, 0, r->plen);
-		bench_end(parse);
+		for(int64_t j = 0; j < 2; j++) {
+			bench_start(search);
+			gaba_dp_search_max(dp, f[j]);
+			bench_end(search);
+
+			bench_start(trace);
+			struct gaba_alignment_s *r = gaba_dp_trace(dp, f[j], NULL);
+			bench_end(trace);
+
+			bench_start(parse);
+			gaba_dump_cigar_forward(c, p.len, r->path, 0, r->plen);
+			bench_end(parse);
+		}
 
 		gaba_dp_clean(dp);
 	}
 	
 	/**
-	 * print results.
+	 * print results; the search time (the max search alone, which is repeated in the trace) is in the last column.
 	 */
-	printf("%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\n",
+	printf("%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\t%" PRId64 "\n",
 		bench_get(fill),
 		bench_get(trace),
 		bench_get(parse),
 		bench_get(fill) + bench_get(trace) + bench_get(parse),
-		score);
+		score,
+		bench_get(search));
 
 	/**
 	 * clean malloc'd memories
 	 */
-	free(remove_margin(a));
-	free(remove_margin(b));
+	for(i = 0; i < 2; i++) {
+		free(remove_margin(a[i]));
+		free(remove_margin(b[i]));
+	}
 	free(c);
 
 	gaba_clean(ctx);
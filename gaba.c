@@ -36,6 +36,7 @@
 #include <stdio.h>				/* sprintf in dump_path */
 #include <stdint.h>				/* uint32_t, uint64_t, ... */
 #include <stddef.h>				/* offsetof */
+#include <stdlib.h>				/* qsort */
 #include <string.h>				/* memset, memcpy */
 #include <inttypes.h>
 
@@ -64,7 +65,48 @@
 #  define MODEL					AFFINE
 #endif
 
-#if MODEL == LINEAR
+/**
+ * difference lane width: 8 (default) or 16 bits. the 16-bit lanes are for the scoring schemes whose difference
+ * values do not fit in int8 (rejected by gaba_init_check_score in the 8-bit kernels), at the cost of doubling
+ * the vector width. they are built for the 16-, 32-, and 64-cell bands.
+ */
+#ifdef DIFF
+#  if !(DIFF == 8 || DIFF == 16)
+#    error "DIFF must be 8 or 16."
+#  endif
+#else
+#  define DIFF						8
+#endif
+
+/**
+ * block length (log2): 5 (32 vectors, default) or 6 (64 vectors). a block is the unit of the sequence fetch,
+ * the X-drop test, and the memory allocation, and its direction array is held in a 32- or 64-bit mask. the
+ * 8-bit lanes keep 32-vector blocks (see BLK below), and all the kernels linked into a binary must be built
+ * with the same BLK_BASE.
+ */
+#ifdef BLK_BASE
+#  if !(BLK_BASE == 5 || BLK_BASE == 6)
+#    error "BLK_BASE must be 5 (32 vectors) or 6 (64 vectors)."
+#  endif
+#else
+#  define BLK_BASE					5
+#endif
+
+#if defined(PRESET)
+#  define MODEL_LABEL				_preset_label_cat(preset, PRESET)
+#  define MODEL_STR					"affine (preset)"
+#  define _preset_label_cat_intl(x, y)	x##y
+#  define _preset_label_cat(x, y)		_preset_label_cat_intl(x, y)
+#elif DIFF == 16 && MODEL == LINEAR
+#  define MODEL_LABEL				linear16
+#  define MODEL_STR					"linear (16-bit)"
+#elif DIFF == 16 && MODEL == AFFINE
+#  define MODEL_LABEL				affine16
+#  define MODEL_STR					"affine (16-bit)"
+#elif DIFF == 16
+#  define MODEL_LABEL				combined16
+#  define MODEL_STR					"combined (16-bit)"
+#elif MODEL == LINEAR
 #  define MODEL_LABEL				linear
 #  define MODEL_STR					"linear"
 #elif MODEL == AFFINE
@@ -88,7 +130,7 @@
 
 
 /* bandwidth-specific configurations aliasing vector macros */
-#define BW_MAX						64
+#define BW_MAX						256
 #ifndef BW
 #  define BW						64
 #endif
@@ -106,13 +148,162 @@
 #  define _NVEC_ALIAS_PREFIX		v64i8
 #  define _WVEC_ALIAS_PREFIX		v64i16
 #  define DP_CTX_INDEX				0
+#elif _W == 128
+#  define _NVEC_ALIAS_PREFIX		v128i8
+#  define _WVEC_ALIAS_PREFIX		v128i16
+#  define DP_CTX_INDEX				3
+#elif _W == 256
+#  define _NVEC_ALIAS_PREFIX		v256i8
+#  define _WVEC_ALIAS_PREFIX		v256i16
+#  define DP_CTX_INDEX				4
 #else
-#  error "BW must be one of 16, 32, or 64."
+#  error "BW must be one of 16, 32, 64, 128, or 256."
 #endif
 #include "arch/vector_alias.h"
 
-#define DP_CTX_MAX					( 3 )
-#define _dp_ctx_index(_bw)			( ((_bw) == 64) ? 0 : (((_bw) == 32) ? 1 : 2) )
+
+/* scoring preset specialization: the score vectors are compile-time constants instead of the ones in the dp context (see GABA_PRESET_* in gaba.h) */
+#ifdef PRESET
+#  if !(PRESET >= 1 && PRESET <= GABA_PRESET_CNT)
+#    error "PRESET must be one of the GABA_PRESET_* indices."
+#  endif
+#  if MODEL != AFFINE
+#    error "the presets are in the affine-gap model."
+#  endif
+#  if BW > 64
+#    error "the presets are built for the 16-, 32-, and 64-cell bands."
+#  endif
+#  define _preset_apply(_f, ...)	_f(__VA_ARGS__)
+#  define _preset_m(_m, _x, _gi, _ge)	( _m )
+#  define _preset_x(_m, _x, _gi, _ge)	( _x )
+#  define _preset_gi(_m, _x, _gi, _ge)	( _gi )
+#  define _preset_ge(_m, _x, _gi, _ge)	( _ge )
+#  define PRESET_M					_preset_apply(_preset_m, _gaba_preset(PRESET))
+#  define PRESET_X					_preset_apply(_preset_x, _gaba_preset(PRESET))
+#  define PRESET_GI					_preset_apply(_preset_gi, _gaba_preset(PRESET))
+#  define PRESET_GE					_preset_apply(_preset_ge, _gaba_preset(PRESET))
+#  define PRESET_SB_OFS				( 2 * (PRESET_GI + PRESET_GE) )
+
+/* same as gaba_init_score_vector */
+static int8_t const preset_sb[16] __attribute__(( aligned(16) )) = {
+#  if BIT == 4
+	-PRESET_X + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS,
+	PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS,
+	PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS,
+	PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS
+#  else
+	PRESET_M + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS,
+	-PRESET_X + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS,
+	-PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS,
+	-PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, -PRESET_X + PRESET_SB_OFS, PRESET_M + PRESET_SB_OFS
+#  endif
+};
+
+/*
+ * gap vectors; loaded through a pointer that the compiler cannot see through. gcc otherwise rebuilds the
+ * uniform constants with broadcasts from general-purpose registers, which compete with the shuffles for
+ * the port in the inner loop (measured slower than loading the vectors from the context).
+ */
+#  define _preset_rep16(x)			x, x, x, x, x, x, x, x, x, x, x, x, x, x, x, x
+#  define _preset_rep64(x)			_preset_rep16(x), _preset_rep16(x), _preset_rep16(x), _preset_rep16(x)
+static int8_t const preset_adj[64] __attribute__(( aligned(64) )) = { _preset_rep64(PRESET_GI) };
+static int8_t const preset_ofs[64] __attribute__(( aligned(64) )) = { _preset_rep64(-PRESET_GI - PRESET_GE) };
+
+/* override the score vector loaders; they are no longer bound to the dp context */
+#  undef _load_sb
+#  undef _load_adjh
+#  undef _load_adjv
+#  undef _load_ofsh
+#  undef _load_ofsv
+#  define _load_sb(_scv)			( _from_v16i8_n(_load_v16i8(preset_sb)) )
+#  define _load_preset(_ptr)		({ int8_t const *_p = (_ptr); __asm__( "" : "+r"(_p) ); _load_n(_p); })
+#  define _load_adjh(_scv)			( _load_preset(preset_adj) )
+#  define _load_adjv(_scv)			( _load_preset(preset_adj) )
+#  define _load_ofsh(_scv)			( _load_preset(preset_ofs) )
+#  define _load_ofsv(_scv)			( _load_preset(preset_ofs) )
+#endif
+
+/* difference lane aliases; the diff, drop, and small delta vectors are held in nvec_t (8-bit) or wvec_t (16-bit) */
+#if DIFF == 8
+typedef uint8_t diff_lane_t;
+typedef int8_t drop_lane_t;
+#  define dvec_t					nvec_t
+#  define _load_d					_load_n
+#  define _loadu_d					_loadu_n
+#  define _store_d					_store_n
+#  define _storeu_d					_storeu_n
+#  define _set_d					_set_n
+#  define _zero_d					_zero_n
+#  define _add_d					_add_n
+#  define _sub_d					_sub_n
+#  define _subs_d					_subs_n
+#  define _max_d					_max_n
+#  define _bsl_d					_bsl_n
+#  define _bsr_d					_bsr_n
+#  define _ext_d					_ext_n
+#  define _mask_eq_d				_mask_eq_n
+#  define _mask_gt_d				_mask_gt_n
+#  define _cvt_d_w					_cvt_n_w
+#  define _cvt_w_d					_cvt_w_n
+#  define _print_d					_print_n
+#  define _shuf_sb_d(_scv, _m)		( _shuf_n(_load_sb(_scv), (_m)) )
+#  define _xstat_d(_x)				( (_x) & TERM )
+#  define DIFF_MAX					( INT8_MAX )
+#  define XDROP_MAX					( INT8_MAX )
+#else
+#  if BW > 64
+#    error "the 16-bit difference lanes are built for the 16-, 32-, and 64-cell bands."
+#  endif
+#  if defined(PRESET)
+#    error "the presets are in the 8-bit difference lanes."
+#  endif
+typedef int16_t diff_lane_t;
+typedef int16_t drop_lane_t;
+#  define dvec_t					wvec_t
+#  define _load_d					_load_w
+#  define _loadu_d					_loadu_w
+#  define _store_d					_store_w
+#  define _storeu_d					_storeu_w
+#  define _set_d					_set_w
+#  define _zero_d					_zero_w
+#  define _add_d					_add_w
+#  define _sub_d					_sub_w
+#  define _subs_d(_a, _b)			( _max_w(_subs_w(_a, _b), _set_w(-128)) )
+#  define _max_d					_max_w
+#  define _bsl_d					_bsl_w
+#  define _bsr_d					_bsr_w
+#  define _ext_d					_ext_w
+#  define _mask_eq_d				_mask_eq_w
+#  define _mask_gt_d				_mask_gt_w
+#  define _cvt_d_w(_x)				( _x )
+#  define _cvt_w_d(_x)				( _x )
+#  define _print_d					_print_w
+#  define _xstat_d(_x)				( ((_x) < 0) ? TERM : 0 )
+#  define DIFF_MAX					( INT16_MAX / 64 )		/* a lane-to-lane difference times the 64-cell band stays in int16 */
+#  define XDROP_MAX					( INT16_MAX )			/* the drop lanes saturate at INT16_MAX > xdrop - 128 */
+
+/*
+ * the substitution matrix is kept without the offset in the 16-bit lanes, and the gap vectors are broadcast
+ * from the int16 constants in the last row of the score vector (unused in the 8-bit lanes; see gaba_init_score_vector)
+ */
+#  define _scv_w(_scv)				( (int16_t const *)(_scv).v5 )
+#  define _shuf_sb_d(_scv, _m)		( _add_w(_cvt_n_w(_shuf_n(_load_sb(_scv), (_m))), _set_w(_scv_w(_scv)[4])) )
+#  undef _load_adjh
+#  undef _load_adjv
+#  undef _load_ofsh
+#  undef _load_ofsv
+#  undef _load_gfh
+#  undef _load_gfv
+#  define _load_adjh(_scv)			( _set_w(_scv_w(_scv)[0]) )
+#  define _load_adjv(_scv)			( _set_w(_scv_w(_scv)[0]) )
+#  define _load_ofsh(_scv)			( _set_w(_scv_w(_scv)[1]) )
+#  define _load_ofsv(_scv)			( _set_w(_scv_w(_scv)[1]) )
+#  define _load_gfh(_scv)			( _set_w(_scv_w(_scv)[2]) )
+#  define _load_gfv(_scv)			( _set_w(_scv_w(_scv)[3]) )
+#endif
+
+#define DP_CTX_MAX					( 5 )
+#define _dp_ctx_index(_bw)			( ((_bw) <= 64) ? (((_bw) == 64) ? 0 : (((_bw) == 32) ? 1 : 2)) : (((_bw) == 128) ? 3 : 4) )
 // _static_assert(_dp_ctx_index(BW) == DP_CTX_INDEX);
 
 
@@ -136,31 +327,53 @@
 #endif
 
 
-/* import unittest */
+/* import unittest (the prefix is overridden when kernels for several instruction sets are linked together) */
+#ifndef UNITTEST_UNIQUE_ID_PREFIX
+#  define UNITTEST_UNIQUE_ID_PREFIX	3
+#endif
+#define _ut_id_cat(x, y)			x##y
+#define _ut_id_cat2(x, y)			_ut_id_cat(x, y)
+#define _ut_id(_n)					_ut_id_cat2(UNITTEST_UNIQUE_ID_PREFIX, _n)
 #ifndef UNITTEST_UNIQUE_ID
-#  if MODEL == LINEAR
+#  if defined(PRESET)
+#    define UNITTEST_UNIQUE_ID	_ut_id_cat2(_ut_id(PRESET), BW)
+#  elif DIFF == 16
+#    define UNITTEST_UNIQUE_ID	_ut_id_cat2(_ut_id_cat2(_ut_id(0), MODEL), BW)
+#  elif MODEL == LINEAR
 #    if BW == 16
-#      define UNITTEST_UNIQUE_ID	31
+#      define UNITTEST_UNIQUE_ID	_ut_id(1)
 #    elif BW == 32
-#      define UNITTEST_UNIQUE_ID	32
+#      define UNITTEST_UNIQUE_ID	_ut_id(2)
+#    elif BW == 64
+#      define UNITTEST_UNIQUE_ID	_ut_id(3)
+#    elif BW == 128
+#      define UNITTEST_UNIQUE_ID	_ut_id(10)
 #    else
-#      define UNITTEST_UNIQUE_ID	33
+#      define UNITTEST_UNIQUE_ID	_ut_id(11)
 #    endif
 #  elif MODEL == AFFINE
 #    if BW == 16
-#      define UNITTEST_UNIQUE_ID	34
+#      define UNITTEST_UNIQUE_ID	_ut_id(4)
 #    elif BW == 32
-#      define UNITTEST_UNIQUE_ID	35
+#      define UNITTEST_UNIQUE_ID	_ut_id(5)
+#    elif BW == 64
+#      define UNITTEST_UNIQUE_ID	_ut_id(6)
+#    elif BW == 128
+#      define UNITTEST_UNIQUE_ID	_ut_id(12)
 #    else
-#      define UNITTEST_UNIQUE_ID	36
+#      define UNITTEST_UNIQUE_ID	_ut_id(13)
 #    endif
 #  else
 #    if BW == 16
-#      define UNITTEST_UNIQUE_ID	37
+#      define UNITTEST_UNIQUE_ID	_ut_id(7)
 #    elif BW == 32
-#      define UNITTEST_UNIQUE_ID	38
+#      define UNITTEST_UNIQUE_ID	_ut_id(8)
+#    elif BW == 64
+#      define UNITTEST_UNIQUE_ID	_ut_id(9)
+#    elif BW == 128
+#      define UNITTEST_UNIQUE_ID	_ut_id(14)
 #    else
-#      define UNITTEST_UNIQUE_ID	39
+#      define UNITTEST_UNIQUE_ID	_ut_id(15)
 #    endif
 #  endif
 #endif
@@ -173,20 +386,24 @@
 #define _static_assert(expr)	typedef char _sa_cat(_st, __LINE__)[(expr) ? 1 : -1]
 
 
-/* internal constants */
-#define BLK_BASE					( 5 )
-#define BLK						( 0x01<<BLK_BASE )
+/* internal constants; the small deltas in the 8-bit lanes may wrap around more than once in 64 vectors */
+#define BLK_MAX					( 0x01<<BLK_BASE )
+#if DIFF == 8
+#  define BLK						( 32 )
+#else
+#  define BLK						BLK_MAX
+#endif
 
 #ifdef DEBUG_MEM
 #  define MIN_BULK_BLOCKS			( 0 )
 #  define MEM_ALIGN_SIZE			( 32 )		/* 32byte aligned for AVX2 environments */
 #  define MEM_INIT_SIZE				( (uint64_t)4 * 1024 )
-#  define MEM_MARGIN_SIZE			( 4096 )	/* tail margin of internal memory blocks */
+#  define MEM_MARGIN_SIZE			( 512 * BLK_MAX )	/* tail margin of internal memory blocks (covers two 256-cell blocks) */
 #else
 #  define MIN_BULK_BLOCKS			( 32 )
 #  define MEM_ALIGN_SIZE			( 32 )		/* 32byte aligned for AVX2 environments */
 #  define MEM_INIT_SIZE				( (uint64_t)256 * 1024 * 1024  )
-#  define MEM_MARGIN_SIZE			( 4096 )	/* tail margin of internal memory blocks */
+#  define MEM_MARGIN_SIZE			( 512 * BLK_MAX )	/* tail margin of internal memory blocks (covers two 256-cell blocks) */
 #endif
 
 #define INIT_FETCH_APOS				( -1 )
@@ -239,9 +456,9 @@ struct gaba_dp_context_s;
  * @struct gaba_drop_s
  */
 struct gaba_drop_s {
-	int8_t drop[_W];					/** (32) max */
+	drop_lane_t drop[_W];				/** (32) max */
 };
-_static_assert(sizeof(struct gaba_drop_s) == _W);
+_static_assert(sizeof(struct gaba_drop_s) == sizeof(drop_lane_t) * _W);
 
 /**
  * @struct gaba_middle_delta_s
@@ -271,23 +488,74 @@ _static_assert(sizeof(struct gaba_mask_pair_s) == _W / 2);
 #endif
 #define _mask_u64(_m)				( ((nvec_masku_t){ .mask = (_m) }).all )
 
+/**
+ * @type lmask_t
+ * @brief lanewise bit mask; a uint64_t up to 64 cells, an array of uint64_t (the mask struct) for wider bands
+ */
+#if _W <= 64
+typedef uint64_t lmask_t;
+#  define _lmask(_m)				_mask_u64(_m)
+#  define _lmask_load(_u)			( (_u).all )
+#  define _lmask_store(_u, _l)		( (_u).all = (_l) )
+#  define _lmask_bit(_u, _q)		( ((_u).all>>(_q)) & 0x01 )
+#  define _lmask_or(_x, _y)			( (_x) | (_y) )
+#  define _lmask_and(_x, _y)		( (_x) & (_y) )
+#  define _lmask_andn(_x, _y)		( ~(_x) & (_y) )
+#  define _lmask_is_zero(_x)		( (_x) == 0 )
+#  define _lmask_tzcnt(_x)			tzcnt(_x)
+#  define _lmask_lo64(_x)			( (uint64_t)(_x) )
+#else
+typedef nvec_mask_t lmask_t;
+#  define _lmask(_m)				( _m )
+#  define _lmask_load(_u)			( (_u).mask )
+#  define _lmask_store(_u, _l)		( (_u).mask = (_l) )
+#  define _lmask_bit(_u, _q)		( ((_u).all[(_q)>>6]>>((_q) & 0x3f)) & 0x01 )
+#  define _lmask_lo64(_x)			( (_x).m[0] )
+#define _lmask_op(_name, _expr) \
+	static _force_inline \
+	lmask_t _name(lmask_t x, lmask_t y) \
+	{ \
+		for(uint64_t i = 0; i < _W / 64; i++) { x.m[i] = (_expr); } \
+		return(x); \
+	}
+_lmask_op(_lmask_or, x.m[i] | y.m[i])
+_lmask_op(_lmask_and, x.m[i] & y.m[i])
+_lmask_op(_lmask_andn, ~x.m[i] & y.m[i])
+#undef _lmask_op
+static _force_inline
+uint64_t _lmask_is_zero(lmask_t x)
+{
+	uint64_t a = 0;
+	for(uint64_t i = 0; i < _W / 64; i++) { a |= x.m[i]; }
+	return(a == 0);
+}
+static _force_inline
+uint64_t _lmask_tzcnt(lmask_t x)
+{
+	for(uint64_t i = 0; i < _W / 64 - 1; i++) {
+		if(x.m[i] != 0) { return(64 * i + tzcnt(x.m[i])); }
+	}
+	return(_W - 64 + tzcnt(x.m[_W / 64 - 1]));
+}
+#endif
+
 /**
  * @struct gaba_diff_vec_s
  */
 #if MODEL == LINEAR
 struct gaba_diff_vec_s {
-	uint8_t dh[_W];						/** (32) dh */
-	uint8_t dv[_W];						/** (32) dv */
+	diff_lane_t dh[_W];					/** (32) dh */
+	diff_lane_t dv[_W];					/** (32) dv */
 };
-_static_assert(sizeof(struct gaba_diff_vec_s) == 2 * _W);
+_static_assert(sizeof(struct gaba_diff_vec_s) == 2 * sizeof(diff_lane_t) * _W);
 #else	/* affine and combined gap penalty */
 struct gaba_diff_vec_s {
-	uint8_t dh[_W];						/** (32) dh */
-	uint8_t dv[_W];						/** (32) dv */
-	uint8_t de[_W];						/** (32) de */
-	uint8_t df[_W];						/** (32) df */
+	diff_lane_t dh[_W];					/** (32) dh */
+	diff_lane_t dv[_W];					/** (32) dv */
+	diff_lane_t de[_W];					/** (32) de */
+	diff_lane_t df[_W];					/** (32) df */
 };
-_static_assert(sizeof(struct gaba_diff_vec_s) == 4 * _W);
+_static_assert(sizeof(struct gaba_diff_vec_s) == 4 * sizeof(diff_lane_t) * _W);
 #endif
 
 /**
@@ -298,28 +566,70 @@ struct gaba_char_vec_s {
 };
 _static_assert(sizeof(struct gaba_char_vec_s) == _W);
 
+/**
+ * @type dir_mask_t
+ * @brief extension direction bit array of a block, one bit per vector
+ */
+#if BLK == 32
+typedef uint32_t dir_mask_t;
+#else
+typedef uint64_t dir_mask_t;
+#endif
+
+/**
+ * @type path_array_t
+ * @brief the traceback loop keeps the path of a block and the one after it in a register; the path array is
+ * handled in 32-bit words regardless of the block length (the traceback may continue in another kernel)
+ */
+#if BLK == 32
+typedef uint64_t path_array_t;
+#  define _loadu_path(_p)			_loadu_u64(_p)
+#  define _storeu_path(_p, _e)		_storeu_u64(_p, _e)
+#else
+typedef unsigned __int128 path_array_t;
+#  define _loadu_path(_p)			( ((path_array_t)_loadu_u64((_p) + 2)<<64) | _loadu_u64(_p) )
+#  define _storeu_path(_p, _e)		{ path_array_t _a = (_e); _storeu_u64((_p), (uint64_t)_a); _storeu_u64((_p) + 2, (uint64_t)(_a>>64)); }
+#endif
+
 /**
  * @struct gaba_block_s
- * @brief a unit of banded matrix, 32 vector updates will be recorded in a single block object.
+ * @brief a unit of banded matrix, 32 (or 64) vector updates will be recorded in a single block object.
  * phantom is an alias of the block struct as a head cap of contiguous blocks.
  */
 struct gaba_block_s {
-	struct gaba_mask_pair_s mask[BLK];	/** (256 / 512) traceback capability flag vectors (set if transition to the ajdacent cell is possible) */
+	struct gaba_mask_pair_s mask[BLK];	/** (256 / 512, doubled in the 64-vector blocks) traceback capability flag vectors (set if transition to the ajdacent cell is possible) */
 	struct gaba_diff_vec_s diff;		/** (64, 128, 256) diff variables of the last vector */
 	int8_t acc, xstat;					/** (2) accumulator, and xdrop status (term detected when xstat < 0) */
 	int8_t acnt, bcnt;					/** (2) forwarded lengths */
-	uint32_t dir_mask;					/** (4) extension direction bit array */
-	uint64_t max_mask;					/** (8) lanewise update mask (set if the lane contains the current max) */
+#if BLK == 64
+	uint32_t _pad1;						/** (4) keep dir_mask aligned to 8byte boundary */
+#endif
+	dir_mask_t dir_mask;				/** (4, 8) extension direction bit array */
+	lmask_t max_mask;					/** (8, 16, 32) lanewise update mask (set if the lane contains the current max) */
+#if (_W > 64) != (BLK == 64)
+	uint64_t _pad;						/** (8) keep aligned to 16byte boundary */
+#endif
 };
 struct gaba_phantom_s {
 	struct gaba_diff_vec_s diff;		/** (64, 128, 256) diff variables of the last (just before the head) vector */
 	int8_t acc, xstat;					/** (2) accumulator, and xdrop status (term detected when xstat < 0) */
 	int8_t acnt, bcnt;					/** (4) prefetched sequence lengths (only effective at the root, otherwise zero) */
-	uint32_t reserved;					/** (4) overlaps with dir_mask */
+#if BLK == 64
+	uint32_t _pad1;						/** (4) overlaps with _pad1 */
+#endif
+	dir_mask_t reserved;				/** (4, 8) overlaps with dir_mask */
 	struct gaba_block_s const *blk;		/** (8) link to the previous block (overlaps with max_mask) */
+#if BLK == 32 && _W > 64
+	uint8_t _pad[_W / 8];				/** (16, 32) overlaps with the rest of max_mask */
+#elif BLK == 64 && _W > 64
+	uint8_t _pad[_W / 8 - 8];			/** (8, 24) overlaps with the rest of max_mask */
+#elif BLK == 64
+	uint64_t _pad;						/** (8) overlaps with _pad */
+#endif
 };
 _static_assert(sizeof(struct gaba_block_s) % 16 == 0);
 _static_assert(sizeof(struct gaba_phantom_s) % 16 == 0);
+_static_assert(sizeof(struct gaba_block_s) - offsetof(struct gaba_block_s, diff) == sizeof(struct gaba_phantom_s));
 #define _last_block(x)				( (struct gaba_block_s *)(x) - 1 )
 #define _last_phantom(x)			( (struct gaba_phantom_s *)(x) - 1 )
 #define _phantom(x)					( _last_phantom((struct gaba_block_s *)(x) + 1) )
@@ -333,6 +643,12 @@ struct gaba_merge_s {
 	int8_t tidx[2][_W];					/** (32, 64, 128) lanewise index array */
 	struct gaba_diff_vec_s diff;		/** (64, 128, 256) diff variables of the last (just before the head) vector */
 	int8_t acc, xstat;					/** (2) acc and xstat are reserved for block_s */
+#if _W > 64
+	uint8_t reserved3[_W / 8];			/** (16, 32) max_mask is wider than uint64_t */
+#endif
+#if BLK == 64 && _W <= 64
+	uint8_t reserved4[16];				/** (16) _pad1, the wider dir_mask, and _pad of block_s */
+#endif
 	uint8_t reserved2[13], qofs[1];		/** (14) displacement of vectors in the q-direction */
 };
 #define MERGE_TAIL_OFFSET			( BLK * sizeof(struct gaba_mask_pair_s) - 2 * _W - 2 * sizeof(void *) )
@@ -341,17 +657,39 @@ _static_assert(sizeof(struct gaba_merge_s) % 16 == 0);
 _static_assert(sizeof(struct gaba_merge_s) + MERGE_TAIL_OFFSET == sizeof(struct gaba_block_s));
 _static_assert(MAX_MERGE_COUNT <= 14);
 
+/**
+ * @struct gaba_conv_s
+ * @brief header of the phantom block of a converted band (gaba_dp_import_band), holds the kernel functions
+ * of the previous band. the traceback and the max search are continued (or delegated) to the previous kernel
+ * when they reach the phantom.
+ */
+struct gaba_conv_s {
+	struct gaba_alignment_s *(*resume)(		/** (8) continues the traceback in the previous band from its last vector */
+		struct gaba_dp_context_s *self,
+		void const *blk,
+		uint32_t q);
+	struct gaba_alignment_s *(*trace)(		/** (8) gaba_dp_trace of the previous band (exported) */
+		struct gaba_dp_context_s *self,
+		struct gaba_fill_s const *fill,
+		struct gaba_alloc_s const *alloc);
+	struct gaba_pos_pair_s *(*search)(		/** (8) gaba_dp_search_max of the previous band (exported) */
+		struct gaba_dp_context_s *self,
+		struct gaba_fill_s const *fill);
+	int32_t qofs;							/** (4) lane q of the converted band is lane (q - qofs) of the previous band */
+	uint32_t bw;							/** (4) band width of the previous band */
+};
+_static_assert(sizeof(struct gaba_conv_s) % 16 == 0);
+#define _conv(x)					( (struct gaba_conv_s const *)_phantom(x) - 1 )
+#define _conv_prev(x)				( ((struct gaba_joint_tail_s const *)((struct gaba_block_s const *)(x) + 1))->tail )	/* tail of the previous band */
+
 /**
  * @struct gaba_joint_tail_s
  * @brief (internal) tail cap of a contiguous matrix blocks, contains a context of the blocks
- * (band) and can be connected to the next blocks.
+ * (band) and can be connected to the next blocks. the vectors are placed after the fill object
+ * so that the other fields are at the same offsets in all the band widths (the tails of different
+ * widths are chained by gaba_dp_convert).
  */
 struct gaba_joint_tail_s {
-	/* char vector and delta vectors */
-	struct gaba_char_vec_s ch;			/** (16, 32, 64) char vector */
-	struct gaba_drop_s xd;				/** (16, 32, 64) */
-	struct gaba_middle_delta_s md;		/** (32, 64, 128) */
-
 	int16_t mdrop;						/** (2) drop from m.max (offset) */
 	uint16_t istat;						/** (2) 1 if bridge */
 	uint32_t pridx;						/** (4) remaining p-length */
@@ -360,9 +698,25 @@ struct gaba_joint_tail_s {
 	struct gaba_joint_tail_s const *tail;/** (8) the previous tail */
 	uint64_t abrk, bbrk;				/** (16) breakpoint masks */
 	uint8_t const *atptr, *btptr;		/** (16) tail of the current section */
-	struct gaba_fill_s f;				/** (24) */
+	uint64_t mapos, mbpos;				/** (16) f.apos and f.bpos at the tail of mblk */
+	struct gaba_block_s const *mblk;	/** (8) block that first reached the max (score-only fill; NULL if the max is at the root) */
+	int64_t eapos, ebpos;				/** (16) f.apos and f.bpos where the band reached the ends of the terminal sections (EPOS_NONE if not reached) */
+	int64_t emax;						/** (8) best score of the end cells with the end bonus (INT64_MIN if none) */
+	struct gaba_block_s const *eblk;	/** (8) block containing the best end cell */
+	uint16_t fmode, estat;				/** (4) fill mode (GABA_FILL_FULL or GABA_FILL_SCORE_ONLY), and (p, q) of the best end cell in eblk (ESTAT_MAX if the max is on it) */
+	uint32_t zdiag;						/** (4) diagonal of the max (Z-drop) */
+	struct gaba_fill_s f;				/** (64) */
+
+	/* char vector and delta vectors */
+	struct gaba_char_vec_s ch;			/** (16, 32, 64) char vector */
+	struct gaba_drop_s xd;				/** (16, 32, 64) */
+#if _W == 16 && DIFF == 16
+	uint8_t _pad1[16];					/** (16) keep aligned to 32-byte boundary */
+#endif
+	struct gaba_middle_delta_s md;		/** (32, 64, 128) */
 };
 _static_assert((sizeof(struct gaba_joint_tail_s) % 32) == 0);
+_static_assert(offsetof(struct gaba_joint_tail_s, f) == 128);		/* common to all the band widths */
 #define TAIL_BASE				( offsetof(struct gaba_joint_tail_s, f) )
 #define BRIDGE_TAIL_OFFSET		( offsetof(struct gaba_joint_tail_s, mdrop) )
 #define BRIDGE_TAIL_SIZE		( sizeof(struct gaba_joint_tail_s) - BRIDGE_TAIL_OFFSET )
@@ -370,24 +724,53 @@ _static_assert((sizeof(struct gaba_joint_tail_s) % 32) == 0);
 #define _tail(x)				( (struct gaba_joint_tail_s *)((uint8_t *)(x) - TAIL_BASE) )
 #define _fill(x)				( (struct gaba_fill_s *)((uint8_t *)(x) + TAIL_BASE) )
 #define _offset(x)				( (x)->f.max - (x)->mdrop )
+#define EPOS_NONE				( INT64_MAX / 2 )	/* far enough from any position not to overflow in the window tests */
+#define ESTAT_MAX				( 0x8000 )
+#define _estat(_p, _q)			( ((_p)<<8) | (_q) )
+
+/**
+ * @struct gaba_band_s
+ * @brief (internal) width-independent copy of the last vector of a band, passed from gaba_dp_export_band
+ * to gaba_dp_import_band of the other band width
+ */
+struct gaba_band_s {
+	struct gaba_joint_tail_s const *tail;	/** (8) tail of the band (the fields before the vectors are common to all the widths) */
+	struct gaba_block_s const *blk;			/** (8) block that holds the last vector */
+	struct gaba_conv_s c;					/** (32) kernel functions of the band, qofs is set in the import */
+	int32_t acc;							/** (4) accumulator of the direction determiner */
+	uint32_t _pad[3];
+	uint8_t ch[BW_MAX];						/** char vector */
+	drop_lane_t xd[BW_MAX];					/** drop vector */
+	int16_t md[BW_MAX];						/** middle delta vector */
+	diff_lane_t dh[BW_MAX], dv[BW_MAX];		/** diff vectors of the last vector */
+	diff_lane_t de[BW_MAX], df[BW_MAX];		/** (unused in the linear-gap kernels) */
+};
 
 #define _mem_blocks(n)				( sizeof(struct gaba_phantom_s) + (n + 1) * sizeof(struct gaba_block_s) + sizeof(struct gaba_joint_tail_s) )
 #define MEM_INIT_VACANCY			( _mem_blocks(MIN_BULK_BLOCKS) )
+#define SCORE_RING_BLOCKS			( 8 )		/* #blocks recycled in the score-only fill */
+#define MEM_SCORE_VACANCY			( _mem_blocks(SCORE_RING_BLOCKS + 2) )	/* ring, and a pair of blocks to keep the max block */
+#define BATCH_REGION_BLOCKS			( 32 )		/* max #blocks reserved for a seed of the batch fill, longer fills continue in the stack */
+#define BATCH_CHUNK_SIZE			( 8 )		/* #seeds passed to the batch root fill at once in gaba_dp_fill_batch */
+#define BATCH_PREFETCH_SIZE			( 256 )		/* #bytes prefetched at the head of the next seeds */
 _static_assert(2 * sizeof(struct gaba_block_s) < MEM_MARGIN_SIZE);
 _static_assert(MEM_INIT_VACANCY < MEM_INIT_SIZE);
 
 /**
  * @struct gaba_root_block_s
+ * @brief the size is common to all the bandwidths (sized for the 256-cell affine phantom and tail)
  */
+#define ROOT_PHANTOM_SIZE			( 1088 )
+#define ROOT_TAIL_SIZE				( 1216 )
 struct gaba_root_block_s {
-	uint8_t _pad1[288 - sizeof(struct gaba_phantom_s)];
+	uint8_t _pad1[ROOT_PHANTOM_SIZE - sizeof(struct gaba_phantom_s)];
 	struct gaba_phantom_s blk;
 	struct gaba_joint_tail_s tail;
-#if _W != 64
-	uint8_t _pad2[352 + 32 - sizeof(struct gaba_joint_tail_s)];
+#if _W != BW_MAX
+	uint8_t _pad2[ROOT_TAIL_SIZE - sizeof(struct gaba_joint_tail_s)];
 #endif
 };
-_static_assert(sizeof(struct gaba_root_block_s) == 640 + 32);
+_static_assert(sizeof(struct gaba_root_block_s) == ROOT_PHANTOM_SIZE + ROOT_TAIL_SIZE);
 _static_assert(sizeof(struct gaba_root_block_s) >= sizeof(struct gaba_phantom_s) + sizeof(struct gaba_joint_tail_s));
 
 /**
@@ -397,9 +780,9 @@ _static_assert(sizeof(struct gaba_root_block_s) >= sizeof(struct gaba_phantom_s)
  */
 struct gaba_reader_work_s {
 	/** 64byte aligned */
-	uint8_t bufa[BW_MAX + BLK];			/** (128) */
-	uint8_t bufb[BW_MAX + BLK];			/** (128) */
-	/** 256 */
+	uint8_t bufa[BW_MAX + BLK_MAX];		/** (288, 320) */
+	uint8_t bufb[BW_MAX + BLK_MAX];		/** (288, 320) */
+	/** 576, 640 */
 
 	/** 64byte alidned */
 	uint32_t arlim, brlim;				/** (8) asridx - aadv = aridx + arlim */
@@ -413,18 +796,36 @@ struct gaba_reader_work_s {
 	/** 64 */
 
 	/** 64byte aligned */
-	struct gaba_drop_s xd;				/** (16, 32, 64) current drop from max */
-#if _W != 64
-	uint8_t _pad[_W == 16 ? 16 : 32];	/** padding to align to 64-byte boundary */
+	struct gaba_block_s const *mblk;	/** (8) block that first reached the current max (score-only fill) */
+	int64_t mmax;						/** (8) current max (score-only fill) */
+	uint64_t mapos, mbpos;				/** (16) f.apos and f.bpos at the tail of mblk */
+	uint32_t fmode, zdiag;				/** (8) fill mode inherited from the previous tail, and diagonal (a - b, mod 2^32) of the current max */
+	int64_t zmax;						/** (8) current max (Z-drop) */
+	int64_t eapos, ebpos;				/** (16) f.apos and f.bpos where the band reached the ends of the terminal sections (end bonus) */
+	/** 64 */
+
+	/** 64byte aligned */
+	int64_t emax;						/** (8) best score of the end cells with the end bonus */
+	struct gaba_block_s const *eblk;	/** (8) block containing the best end cell */
+	uint32_t epq;						/** (4) (p, q) coordinates of the best end cell in eblk */
+	int32_t sdrift;						/** (4) diagonal (a - b) of the center lane from the steering target (GABA_STEER_MAX and GABA_STEER_ANCHOR) */
+	uint64_t _pad4[5];					/** (40) */
+	/** 64 */
+
+	/** 64byte aligned */
+	struct gaba_drop_s xd;				/** (16, 32, 64, 128, 256) current drop from max */
+#if _W < 64 && DIFF == 8
+	uint8_t _pad[_W == 16 ? 16 : 32];	/** padding to align to 64-byte boundary (unnecessary in the 16-bit lanes) */
 #endif
-	struct gaba_middle_delta_s md;		/** (32, 64, 128) */
+	struct gaba_middle_delta_s md;		/** (32, 64, 128, 256, 512) */
 };
 _static_assert((sizeof(struct gaba_reader_work_s) % 64) == 0);
 
 /**
  * @struct gaba_merge_work_s
+ * @brief merge is not supported for bands wider than 64 cells; the buffer is kept at the 64-cell size.
  */
-#define MERGE_BUFFER_LENGTH		( 2 * _W )
+#define MERGE_BUFFER_LENGTH		( 2 * (_W > 64 ? 64 : _W) )
 struct gaba_merge_work_s {
 	uint8_t qofs[16];					/** (16) q-offset array */
 	uint32_t qw, _pad1;					/** (8) */
@@ -488,7 +889,7 @@ struct gaba_writer_work_s {
 	uint32_t afcnt, bfcnt;				/** (8) */
 	uint32_t *path;						/** (8) path array pointer */
 	struct gaba_block_s const *blk;		/** (8) current block */
-	uint8_t p, q, ofs, state, _pad[4];	/** (8) local p, q-coordinate, [0, BW), path offset, state */
+	uint8_t p, q, ofs, state, edge, _pad[3];/** (8) local p, q-coordinate, [0, BW), path offset, state, 1 if the path visited lane 0 or _W - 1 */
 
 	/** save */
 	uint32_t aofs, bofs;				/** (8) ofs for bridge */
@@ -571,24 +972,29 @@ struct gaba_dp_context_s {
 	_barrier(head);
 
 	/** loaded on init */
-	struct gaba_joint_tail_s const *root[4];	/** (32) root tail (phantom vectors) */
+	struct gaba_joint_tail_s const *root[8];	/** (64) root tail (phantom vectors) */
 
 	/* memory management */
 	struct gaba_mem_block_s mem;		/** (16) root memory block */
 	struct gaba_stack_s stack;			/** (24) current stack */
+	int64_t adiag;						/** (8) anchor diagonal (a - b) of GABA_STEER_ANCHOR */
 	uint64_t _pad2;
+	int64_t tb;							/** (8) end bonus (zero if disabled) */
+	int64_t gapos, gbpos;				/** (16) target of the global fill (f.apos and f.bpos at the end cell) */
 
 	/* score constants */
 	double imx, xmx;					/** (16) 1 / (M - X), X / (M - X) (precalculated constants) */
 	struct gaba_score_vec_s scv;		/** (80) substitution matrix and gaps */
 
 	/* scores */
-	int8_t tx;							/** (1) xdrop threshold */
+	int16_t tx;							/** (2) xdrop threshold (offsetted by -128, the bottom of the drop lanes) */
+	int16_t tz;							/** (2) zdrop threshold (zero if disabled) */
 	int8_t tf;							/** (1) filter threshold */
 	int8_t gi, ge, gfa, gfb;			/** (4) negative integers */
 	uint8_t aflen, bflen;				/** (2) short-gap length thresholds */
-	uint8_t ofs,  _pad1[7];				/** (16) */
-	/** 192; 64byte aligned */
+	uint8_t ofs, fmode, steer;			/** (3) gap offset, fill mode of gaba_dp_fill_root, and steering policy */
+	int16_t txlim;						/** (2) upper bound of the xdrop threshold (XDROP_MAX of the kernel) */
+	/** 256; 64byte aligned */
 
 	_barrier(mid);
 
@@ -603,6 +1009,8 @@ struct gaba_dp_context_s {
 	_barrier(tail);
 };
 _static_assert((sizeof(struct gaba_dp_context_s) % 64) == 0);
+_static_assert(sizeof(union gaba_work_s) <= 2048);		/* dp contexts are allocated with the 64-cell size (see gaba_wrap.h) */
+_static_assert(DP_CTX_MAX <= sizeof(((struct gaba_dp_context_s *)0)->root) / sizeof(void *));
 #define GABA_DP_CONTEXT_LOAD_OFFSET	( 0 )
 #define GABA_DP_CONTEXT_LOAD_SIZE	( offsetof(struct gaba_dp_context_s, w) )
 _static_assert((GABA_DP_CONTEXT_LOAD_OFFSET % 64) == 0);
@@ -613,7 +1021,7 @@ _static_assert((GABA_DP_CONTEXT_LOAD_SIZE % 64) == 0);
  * @struct gaba_opaque_s
  */
 struct gaba_opaque_s {
-	void *api[8];
+	void *api[16];
 };
 #define _export_dp_context(_t) ( \
 	(struct gaba_dp_context_s *)(((struct gaba_opaque_s *)(_t)) - DP_CTX_MAX + _dp_ctx_index(BW)) \
@@ -621,6 +1029,9 @@ struct gaba_opaque_s {
 #define _restore_dp_context(_t) ( \
 	(struct gaba_dp_context_s *)(((struct gaba_opaque_s *)(_t)) - _dp_ctx_index(BW) + DP_CTX_MAX) \
 )
+#define _export_dp_context_bw(_t, _bw) ( \
+	(struct gaba_dp_context_s *)(((struct gaba_opaque_s *)(_t)) - DP_CTX_MAX + _dp_ctx_index(_bw)) \
+)
 #define _export_dp_context_global(_t) ( \
 	(struct gaba_dp_context_s *)(((struct gaba_opaque_s *)(_t)) - DP_CTX_MAX + _dp_ctx_index(BW)) \
 )
@@ -642,19 +1053,20 @@ struct gaba_opaque_s {
 #endif
 struct gaba_context_s {
 	/** opaque pointers for function dispatch */
-	struct gaba_opaque_s api[4];		/** function dispatcher, used in gaba_wrap.h */
+	struct gaba_opaque_s api[8];		/** function dispatcher, used in gaba_wrap.h */
 	/** 64byte aligned */
 
 	/** templates */
 	struct gaba_dp_context_s dp;		/** template of thread-local context */
-	uint8_t _pad[ROOT_BLOCK_OFFSET - sizeof(struct gaba_dp_context_s) - 4 * sizeof(struct gaba_opaque_s)];
+	uint8_t _pad[ROOT_BLOCK_OFFSET - sizeof(struct gaba_dp_context_s) - 8 * sizeof(struct gaba_opaque_s)];
 	/** 64byte aligned */
 
 	/** phantom vectors */
-	struct gaba_root_block_s ph[3];		/** (768) template of root vectors, [0] for 16-cell, [1] for 32-cell, [2] for 64-cell */
+	struct gaba_root_block_s ph[DP_CTX_MAX];	/** template of root vectors, indexed by _dp_ctx_index(BW) */
 	/** 64byte aligned */
 };
 _static_assert(offsetof(struct gaba_context_s, ph) == ROOT_BLOCK_OFFSET);
+_static_assert(DP_CTX_MAX <= sizeof(((struct gaba_context_s *)0)->api) / sizeof(struct gaba_opaque_s));
 #define _proot(_c, _bw)				( &(_c)->ph[_dp_ctx_index(_bw)] )
 
 /**
@@ -665,9 +1077,11 @@ enum GABA_BLK_STATUS {
 	/* intermediate states */
 	CONT			= 0,				/* continue */
 	ZERO			= 0x01,				/* internal use */
+	ZDROP			= 0x10,				/* terminated by Z-drop (always with TERM) */
 	TERM			= 0x80,				/* sign bit */
 	STAT_MASK		= ZERO | TERM | CONT,
 	/* head states */
+	CONV			= 0x08,				/* converted head, the previous block is of the other band width (always with HEAD) */
 	HEAD			= 0x20,
 	MERGE			= 0x40,				/* merged head and the corresponding block contains no actual vector (DP cell) */
 	ROOT			= HEAD | MERGE
@@ -675,6 +1089,13 @@ enum GABA_BLK_STATUS {
 _static_assert((int8_t)TERM < 0);		/* make sure TERM is recognezed as a negative value */
 _static_assert((int32_t)CONT<<8 == (int32_t)GABA_CONT);
 _static_assert((int32_t)TERM<<8 == (int32_t)GABA_TERM);
+_static_assert((int32_t)ZDROP<<8 == (int32_t)GABA_ZDROP);
+
+/**
+ * @macro FILL_GLOBAL
+ * @brief internal fill mode of gaba_dp_align_global (following GABA_FILL_FULL and GABA_FILL_SCORE_ONLY)
+ */
+#define FILL_GLOBAL					( 2 )
 
 
 /**
@@ -733,27 +1154,34 @@ void gaba_free(
  * @struct gaba_dir_s
  */
 struct gaba_dir_s {
-	uint32_t mask;
+	dir_mask_t mask;
 	int32_t acc;					/* use 32bit int to avoid (sometimes inefficient) 8bit and 16bit operations on x86_64 GP registers */
+	int32_t drift;					/* diagonal (a - b) of the center lane from the steering target (GABA_STEER_MAX and GABA_STEER_ANCHOR) */
 };
 
 /**
  * @macro _dir_init
  */
-#define _dir_init(_blk) ((struct gaba_dir_s){ .mask = 0, .acc = (_blk)->acc })
+#define _dir_init(_self, _blk) ((struct gaba_dir_s){ .mask = 0, .acc = (_blk)->acc, .drift = (_self)->w.r.sdrift })
 /**
  * @macro _dir_fetch
  */
 #define _dir_fetch(_d) { \
-	(_d).mask <<= 1; (_d).mask |= (uint32_t)((_d).acc < 0);  \
-	debug("fetched dir(%x), %s", (_d).mask, _dir_is_down(_d) ? "go down" : "go right"); \
+	(_d).mask <<= 1; (_d).mask |= (dir_mask_t)((_d).acc < 0);  \
+	debug("fetched dir(%lx), %s", (uint64_t)(_d).mask, _dir_is_down(_d) ? "go down" : "go right"); \
 }
 /**
  * @macro _dir_update
- * @brief update direction determiner for the next band
+ * @brief update direction determiner for the next band; the edge-lane policy is inlined, the others are
+ * in dir_update_steer (the branch is not taken in the default policy)
  */
 #define _dir_update(_d, _vector) { \
-	(_d).acc += _ext_n(_vector, 0) - _ext_n(_vector, _W-1); \
+	int32_t _e = _ext_d(_vector, 0) - _ext_d(_vector, _W-1); \
+	if(_likely(self->steer == GABA_STEER_EDGE)) { \
+		(_d).acc += _e; \
+	} else { \
+		dir_update_steer(self, &(_d), _e); \
+	} \
 	/*debug("acc(%d), (%d, %d)", _dir_acc, _ext_n(_vector, 0), _ext_n(_vector, _W-1));*/ \
 }
 /**
@@ -761,7 +1189,7 @@ struct gaba_dir_s {
  * @brief adjust direction array when termination is detected in the middle of the block
  */
 #define _dir_adjust_remainder(_d, _filled_count) { \
-	debug("adjust remainder, array(%x), shifted array(%x)", (_d).mask, (_d).mask<<(BLK - (_filled_count))); \
+	debug("adjust remainder, array(%lx), shifted array(%lx)", (uint64_t)(_d).mask, (uint64_t)((_d).mask<<(BLK - (_filled_count)))); \
 	(_d).mask <<= (BLK - (_filled_count)); \
 }
 /**
@@ -778,10 +1206,17 @@ struct gaba_dir_s {
 /**
  * @macro _dir_save
  */
+#if DIFF == 8 && BLK == 32
 #define _dir_save(_blk, _d) { \
 	(_blk)->dir_mask = (_d).mask;	/* store mask */ \
 	(_blk)->acc = (_d).acc;			/* store accumulator */ \
 }
+#else
+#define _dir_save(_blk, _d) { \
+	(_blk)->dir_mask = (_d).mask;	/* store mask */ \
+	(_blk)->acc = MAX2(MIN2((_d).acc, INT8_MAX), INT8_MIN);	/* store accumulator, clipped (only its sign matters; it may run out of int8 in the 16-bit lanes or in the 64-vector blocks) */ \
+}
+#endif
 /**
  * @macro _dir_load
  */
@@ -794,6 +1229,35 @@ struct gaba_dir_s {
 	/*debug("load dir cnt(%d), mask(%x), shifted mask(%x)", (int32_t)_filled_count, _d.mask, _d.mask>>(BLK - (_filled_count)));*/ \
 )
 
+/**
+ * @fn dir_update_steer
+ * @brief update direction determiner in the policies other than GABA_STEER_EDGE; e is the gain of the
+ * edge-lane policy (lane 0 minus lane _W - 1), the band goes down when acc is negative.
+ */
+static _force_inline
+void dir_update_steer(
+	struct gaba_dp_context_s const *self,
+	struct gaba_dir_s *d,
+	int32_t e)
+{
+	if(self->steer == GABA_STEER_DAMPED) {
+		/* acc holds the gain shifted by -h while going down and +h while going right, so that the direction is kept until the gain crosses the opposite threshold */
+		int32_t const h = -(self->gi + self->ge);
+		int32_t const b = d->acc < 0 ? h : -h;
+		int32_t const r = d->acc + b + e;
+		d->acc = r - (r < b ? h : -h);
+		return;
+	}
+
+	/* GABA_STEER_MAX and GABA_STEER_ANCHOR; going down decreases a - b, the edge-lane policy decides inside the rail */
+	int32_t const rail = self->steer == GABA_STEER_ANCHOR ? _W / 4 : 0;
+	d->drift += _dir_is_down(*d) ? -1 : 1;
+	d->acc += e;
+	if(d->drift > rail) { d->acc = MIN2(d->acc, -1); }
+	if(d->drift < -rail) { d->acc = MAX2(d->acc, 0); }
+	return;
+}
+
 /**
  * seqreader macros
  */
@@ -897,6 +1361,7 @@ static uint8_t const compshift_mask_b[16] __attribute__(( aligned(16) )) = {
 
 #  define _match_n(_a, _b)		_or_n(_a, _b)
 #  define _match_v16i8(_a, _b)	_or_v16i8(_a, _b)
+#  define _match_v32i8(_a, _b)	_or_v32i8(_a, _b)
 
 #else
 /* 4bit encoding */
@@ -940,10 +1405,12 @@ static uint8_t const comp_mask[16] __attribute__(( aligned(16) )) = {
 
 #  define _match_n(_a, _b)		_and_n(_a, _b)
 #  define _match_v16i8(_a, _b)	_and_v16i8(_a, _b)
+#  define _match_v32i8(_a, _b)	_and_v32i8(_a, _b)
 #endif
 
 /**
  * @fn fill_fetch_seq_a
+ * @brief fetch len (<= BLK) bases in 32-byte chunks; the second chunk is only loaded in the 64-vector blocks
  */
 static _force_inline
 void fill_fetch_seq_a(
@@ -954,24 +1421,25 @@ void fill_fetch_seq_a(
 	if(pos < GABA_EOU) {
 		debug("reverse fetch a: pos(%p), len(%lu)", pos, len);
 		/* reverse fetch: 2 * alen - (2 * alen - pos) + (len - 32) */
-		#ifdef UNSAFE_FETCH
-		v32i8_t ach = _loadu_v32i8(pos + (len - BLK));					/* this may touch the space before the array */
-		_storeu_v32i8(_rd_bufa(self, _W, len), _rvaq_v32i8(ach));		/* reverse */
-		#else
-		v32i8_t ach = _loadu_v32i8(pos);								/* this will not touch the space before the array, but will touch at most 31bytes after the array */
-		_storeu_v32i8(_rd_bufa(self, _W, BLK), _rvaq_v32i8(ach));	/* reverse; will not invade any buf */
-		#endif
+		for(uint64_t i = 0; i < BLK; i += 32) {
+			if(i > 0 && i >= len) { break; }
+			#ifdef UNSAFE_FETCH
+			v32i8_t ach = _loadu_v32i8(pos + (len - 32 - i));				/* this may touch the space before the array */
+			_storeu_v32i8(_rd_bufa(self, _W, len) + i, _rvaq_v32i8(ach));	/* reverse */
+			#else
+			v32i8_t ach = _loadu_v32i8(pos + i);							/* this will not touch the space before the array, but will touch at most 31bytes after the array */
+			_storeu_v32i8(_rd_bufa(self, _W + i, 32), _rvaq_v32i8(ach));	/* reverse; will not invade any buf */
+			#endif
+		}
 	} else {
 		debug("forward fetch a: pos(%p), len(%lu), p(%p)", pos, len, _rev(pos + (len - 1)));
 		/* forward fetch: 2 * alen - pos */
-		#ifdef UNSAFE_FETCH
-		v32i8_t ach = _loadu_v32i8(_rev(pos + (len - 1)));
-		_storeu_v32i8(_rd_bufa(self, _W, len), _fwaq_v32i8(ach));		/* complement */
-		#else
-		v32i8_t ach = _loadu_v32i8(_rev(pos + (len - 1)));
-		// _print_v32i8(ach); _print_v32i8(_fwaq_v32i8(ach));
-		_storeu_v32i8(_rd_bufa(self, _W, len), _fwaq_v32i8(ach));	/* complement; will invade bufa[BLK..BLK+_W] */
-		#endif
+		for(uint64_t i = 0; i < BLK; i += 32) {
+			if(i > 0 && i >= len) { break; }
+			v32i8_t ach = _loadu_v32i8(_rev(pos + (len - 1)) + i);
+			// _print_v32i8(ach); _print_v32i8(_fwaq_v32i8(ach));
+			_storeu_v32i8(_rd_bufa(self, _W, len) + i, _fwaq_v32i8(ach));	/* complement; will invade bufa[BLK..BLK+_W] */
+		}
 	}
 	return;
 }
@@ -1031,6 +1499,7 @@ void fill_fetch_seq_a_n(
 
 /**
  * @fn fill_fetch_seq_b
+ * @brief fetch len (<= BLK) bases in 32-byte chunks as fill_fetch_seq_a
  */
 static _force_inline
 void fill_fetch_seq_b(
@@ -1041,19 +1510,25 @@ void fill_fetch_seq_b(
 	if(pos < GABA_EOU) {
 		debug("forward fetch b: pos(%p), len(%lu)", pos, len);
 		/* forward fetch: pos */
-		v32i8_t bch = _loadu_v32i8(pos);
-		_storeu_v32i8(_rd_bufb(self, _W, len), _fwbq_v32i8(bch));		/* forward; will not invade any buf */
+		for(uint64_t i = 0; i < BLK; i += 32) {
+			if(i > 0 && i >= len) { break; }
+			v32i8_t bch = _loadu_v32i8(pos + i);
+			_storeu_v32i8(_rd_bufb(self, _W + i, len), _fwbq_v32i8(bch));	/* forward; will not invade any buf */
+		}
 	} else {
 		debug("reverse fetch b: pos(%p), len(%lu), p(%p)", pos, len, _rev(pos + len - 1));
 		/* reverse fetch: 2 * blen - pos + (len - 32) */
-		#ifdef UNSAFE_FETCH
-		v32i8_t bch = _loadu_v32i8(_rev(pos) - (BLK - 1));
-		_storeu_v32i8(_rd_bufb(self, _W, len), _rvbq_v32i8(bch));		/* reverse complement */
-		#else
-		v32i8_t bch = _loadu_v32i8(_rev(pos + (len - 1)));
-		// _print_v32i8(bch); _print_v32i8(_rvbq_v32i8(bch));
-		_storeu_v32i8(_rd_bufb(self, _W + len - BLK, BLK), _rvbq_v32i8(bch));	/* reverse complement; not to use swapn for v32i8_t, will invade bufb[0.._W] and bufa */
-		#endif
+		for(uint64_t i = 0; i < BLK; i += 32) {
+			if(i > 0 && i >= len) { break; }
+			#ifdef UNSAFE_FETCH
+			v32i8_t bch = _loadu_v32i8(_rev(pos + i) - (32 - 1));
+			_storeu_v32i8(_rd_bufb(self, _W + i, len), _rvbq_v32i8(bch));	/* reverse complement */
+			#else
+			v32i8_t bch = _loadu_v32i8(_rev(pos + (len - 1 - i)));
+			// _print_v32i8(bch); _print_v32i8(_rvbq_v32i8(bch));
+			_storeu_v32i8(_rd_bufb(self, _W + len - 32 - i, 32), _rvbq_v32i8(bch));	/* reverse complement; not to use swapn for v32i8_t, will invade bufb[0.._W] and bufa */
+			#endif
+		}
 	}
 	return;
 }
@@ -1110,7 +1585,7 @@ void fill_fetch_seq_b_n(
 
 /**
  * @fn fill_fetch_core
- * @brief fetch sequences from current sections, lengths must be shorter than 32 (= BLK)
+ * @brief fetch sequences from current sections, lengths must not exceed BLK
  */
 static _force_inline
 void fill_fetch_core(
@@ -1188,13 +1663,24 @@ int64_t fill_init_fetch(
 	_print_v2i32(srem);
 	_print_v2i32(len);
 
-	/* fetch sequence and store at (0, 0), then save newly loaded sequence lengths */
-	fill_fetch_core(self, 0, _lo32(len), 0, _hi32(len));
-	_print_n(_loadu_n(_rd_bufa(self, _lo32(len), _W)));
-	_print_n(_loadu_n(_rd_bufb(self, _hi32(len), _W)));
+	/*
+	 * fetch sequence and store at (0, 0), then save newly loaded sequence lengths. the head margin
+	 * (_W / 2) exceeds BLK for bands wider than 64 cells, where the sequences are fetched in
+	 * BLK-sized chunks, advancing the buffers by the preceding chunk.
+	 */
+	uint32_t alen = _lo32(len), blen = _hi32(len), acnt = 0, bcnt = 0;
+	while(1) {
+		uint32_t al = MIN2(alen, BLK), bl = MIN2(blen, BLK);
+		fill_fetch_core(self, acnt, al, bcnt, bl);
+		alen -= al; blen -= bl; acnt = al; bcnt = bl;
+		if(alen + blen == 0) { break; }
+		self->w.r.arem -= al; self->w.r.brem -= bl;
+	}
+	_print_n(_loadu_n(_rd_bufa(self, acnt, _W)));
+	_print_n(_loadu_n(_rd_bufb(self, bcnt, _W)));
 
-	/* save fetch length for use in the next block fill / tail construction */
-	_store_v2i8(&blk->acnt, _cvt_v2i32_v2i8(len));
+	/* save fetch length (of the last chunk) for use in the next block fill / tail construction */
+	blk->acnt = acnt; blk->bcnt = bcnt;
 	_store_v2i32(&self->w.r.arem, _sub_v2i32(srem, len));
 
 	return(_hi64(pos) + _hi32(len));
@@ -1228,7 +1714,7 @@ void fill_restore_fetch(
 	_print_v2i32(ofs); _print_v2i32(len);
 
 	/* init buffer with magic (for debugging) */
-	_memset_blk_a(self->w.r.bufa, 0, 2 * (BW_MAX + BLK));
+	_memset_blk_a(self->w.r.bufa, 0, 2 * (BW_MAX + BLK_MAX));
 
 	/* fetch seq a */
 	fill_fetch_seq_a_n(self, _lo32(ofs), tail->atptr - _lo32(cridx), _lo32(len));
@@ -1273,7 +1759,7 @@ void fill_load_section(
 
 	/* calc #bases until the next breakpoint (FIXME: simpler calculation needed) */
 	v2i32_t brem = _seta_v2i32(tzcnt(tail->bbrk) + 1, tzcnt(tail->abrk) + 1);
-	v2i32_t rem = _sel_v2i32(_gt_v2i32(brem, _set_v2i32(_W)),
+	v2i32_t rem = _sel_v2i32(_gt_v2i32(brem, _set_v2i32(MIN2(_W, 64))),	/* breakpoint masks are 64-bit long */
 		ridx,									/* no merging breakpoint found for this extension */
 		_min_v2i32(ridx, brem)					/* merging breakpoint found, bounded by brem */
 	);
@@ -1293,6 +1779,26 @@ void fill_load_section(
 	_store_v2i32(&self->w.r.asridx, ridx);
 	_print_v2i32(ridx);
 
+	/* init the max block (score-only fill); the block is searched only in the section where the max was updated */
+	self->w.r.mblk = NULL;
+	self->w.r.mmax = tail->f.max;
+	_store_v2i64(&self->w.r.mapos, _load_v2i64(&tail->f.apos));
+	self->w.r.fmode = tail->fmode;
+
+	/* init the max and its diagonal for the Z-drop test */
+	self->w.r.zdiag = tail->zdiag;
+	self->w.r.zmax = tail->f.max;
+
+	/* distance of the center lane from the anchor (the max lane is not known until the end of the first block) */
+	self->w.r.sdrift = self->steer == GABA_STEER_ANCHOR ? (int32_t)(tail->f.apos - tail->f.bpos - self->adiag) : 0;
+
+	/* init the best end cell (end bonus) */
+	self->w.r.eapos = tail->eapos;
+	self->w.r.ebpos = tail->ebpos;
+	self->w.r.emax = tail->emax;
+	self->w.r.eblk = tail->eblk;
+	self->w.r.epq = tail->estat & ~ESTAT_MAX;
+
 	/* save tail */
 	self->w.r.tail = tail;
 	return;
@@ -1339,7 +1845,7 @@ struct gaba_joint_tail_s *fill_create_bridge(
 
 	/* copy ch, xd, and md */
 	_storeu_n(tail->ch.w, _loadu_n(prev_tail->ch.w));
-	_storeu_n(tail->xd.drop, _loadu_n(prev_tail->xd.drop));
+	_storeu_d(tail->xd.drop, _loadu_d(prev_tail->xd.drop));
 	_storeu_w(tail->md.delta, _loadu_w(prev_tail->md.delta));
 
 	/* vector position and scores are unchanged */
@@ -1356,6 +1862,19 @@ struct gaba_joint_tail_s *fill_create_bridge(
 	_store_v2i32(&tail->f.aid, id);								/* correct id pair is required */
 	_memcpy_blk_uu(&tail->f.ascnt, &prev_tail->f.ascnt, 32);	/* just copy (unchanged) */
 	tail->f.status = prev_tail->f.status;
+	tail->f.bw = _W;
+
+	/* the fill mode is determined at the root and inherited by the succeeding tails */
+	tail->mblk = NULL;
+	_store_v2i64(&tail->mapos, _load_v2i64(&prev_tail->f.apos));
+	tail->fmode = self->fmode;
+	tail->zdiag = prev_tail->zdiag;
+
+	/* no end cell is reached at the root */
+	tail->eapos = tail->ebpos = EPOS_NONE;
+	tail->emax = INT64_MIN;
+	tail->eblk = NULL;
+	tail->estat = 0;
 	return(tail);
 }
 
@@ -1378,11 +1897,11 @@ struct gaba_block_s *fill_load_vectors(
 	_print_n(ach); _print_n(bch);
 
 	/* copy max and middle delta vectors */
-	nvec_t xd = _loadu_n(&tail->xd);
+	dvec_t xd = _loadu_d(&tail->xd);
 	wvec_t md = _loadu_w(&tail->md);
-	_store_n(&self->w.r.xd, xd);
+	_store_d(&self->w.r.xd, xd);
 	_store_w(&self->w.r.md, md);
-	_print_n(xd);
+	_print_d(xd);
 	_print_w(md);
 
 	/* extract the last block pointer, pass to fill-in loop */
@@ -1406,16 +1925,53 @@ int32_t fill_save_vectors(
 	_storeu_n(&tail->ch, _or_n(ach, _shl_n(bch, 4)));
 
 	/* copy delta vectors */
-	nvec_t xd = _load_n(&self->w.r.xd);				/* gcc-4.8 w/ -mavx2 -mbmi2 has an optimization bug with vpmovsxbw */
+	dvec_t xd = _load_d(&self->w.r.xd);				/* gcc-4.8 w/ -mavx2 -mbmi2 has an optimization bug with vpmovsxbw */
 	wvec_t md = _load_w(&self->w.r.md);
-	_storeu_n(&tail->xd, xd);
+	_storeu_d(&tail->xd, xd);
 	_storeu_w(&tail->md, md);
-	_print_n(xd);
+	_print_d(xd);
 	_print_w(md);
 
 	/* search max section */
-	md = _add_w(md, _cvt_n_w(xd));					/* xd holds drop from max */
-	return(_hmax_w(md));
+	md = _add_w(md, _cvt_d_w(xd));					/* xd holds drop from max */
+	int32_t mdrop = _hmax_w(md);
+
+	/* flag the max on the edge lanes, where the path may run out of the band */
+	nvec_masku_t const edge = { .mask = _mask_w(_eq_w(md, _set_w(mdrop))) };
+	tail->f.status = (_lmask_bit(edge, 0) | _lmask_bit(edge, _W - 1)) ? GABA_BAND_EDGE : 0;
+	return(mdrop);
+}
+static _force_inline
+void fill_save_end_bonus(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail)
+{
+	/*
+	 * the band stops as soon as its front reaches the end of a section, where the last vector has
+	 * lane 0 on the last column of a and lane _W - 1 on the last row of b. the lanes following on
+	 * the lines are evaluated in fill_end_block when the band is continued to the next sections.
+	 */
+	uint32_t const stat = tail->f.status;
+	if((stat & GABA_UPDATE_A) && (tail->f.aid & GABA_TERMINAL)) { self->w.r.eapos = tail->f.apos; }
+	if((stat & GABA_UPDATE_B) && (tail->f.bid & GABA_TERMINAL)) { self->w.r.ebpos = tail->f.bpos; }
+
+	/* the last vector; the end cell at the root (or at the head of a converted band) is not counted */
+	struct gaba_block_s const *b = _last_block(tail);
+	while((b->xstat & (ROOT | CONV)) == HEAD) { b = _phantom(b)->blk; }
+	if((b->xstat & ROOT) == ROOT || (b->xstat & CONV) != 0) { return; }
+
+	int64_t const ofs = _offset(tail) - 128 + self->tb;
+	uint64_t const qa = tail->f.apos - self->w.r.eapos;
+	uint64_t const qb = self->w.r.ebpos - tail->f.bpos + _W - 1;
+	uint64_t const q[2] = { qa, qb };
+	for(uint64_t i = 0; i < 2; i++) {
+		if(q[i] >= _W || ofs + tail->md.delta[q[i]] <= self->w.r.emax) { continue; }
+		self->w.r.emax = ofs + tail->md.delta[q[i]];
+		self->w.r.eblk = b;
+		self->w.r.epq = _estat(b->acnt + b->bcnt - 1, q[i]);
+		debug("end cell updated, blk(%p), q(%lu), emax(%ld)", b, q[i], self->w.r.emax);
+	}
+	return;
 }
 static _force_inline
 struct gaba_joint_tail_s *fill_save_section(
@@ -1451,6 +2007,12 @@ struct gaba_joint_tail_s *fill_save_section(
 	_store_v2i32(&tail->f.aid, id);
 	_print_v2i32(ridx); _print_v2i32(sridx); _print_v2i32(adv);
 
+	/* save the max block (score-only fill) */
+	tail->mblk = self->w.r.mblk;
+	_store_v2i64(&tail->mapos, _load_v2i64(&self->w.r.mapos));
+	tail->fmode = self->w.r.fmode;
+	tail->zdiag = self->w.r.zdiag;
+
 	/* calc end-of-section flag, section counts, and base counts */
 	v2i32_t update = _eq_v2i32(ridx, _zero_v2i32());
 	_store_v2i32(&tail->f.ascnt, _sub_v2i32(
@@ -1466,9 +2028,25 @@ struct gaba_joint_tail_s *fill_save_section(
 
 	/* store max, status flag */
 	tail->f.max = _offset(prev_tail) + self->w.r.ofsd + mdrop;
-	tail->f.status = ((xstat & (TERM | CONT))<<8) | _mask_v2i32(update);
+	tail->f.status |= ((xstat & (TERM | ZDROP))<<8) | _mask_v2i32(update);	/* GABA_BAND_EDGE is set in fill_save_vectors */
+	tail->f.bw = _W;
 	debug("prev_offset(%ld), offset(%ld), max(%d, %ld)",
 		_offset(prev_tail), _offset(prev_tail) + self->w.r.ofsd, mdrop, tail->f.max);
+
+	/* save the best end cell, the max moves to the cell if the end bonus makes it better */
+	if(_unlikely(self->tb != 0 && tail->fmode == GABA_FILL_FULL)) {
+		fill_save_end_bonus(self, tail);
+	}
+	tail->eapos = self->w.r.eapos;
+	tail->ebpos = self->w.r.ebpos;
+	tail->emax = self->w.r.emax;
+	tail->eblk = self->w.r.eblk;
+	tail->estat = self->w.r.epq;
+	if(_unlikely(self->w.r.emax > tail->f.max)) {
+		tail->mdrop += self->w.r.emax - tail->f.max;	/* keep the offset, the vectors are untouched */
+		tail->f.max = self->w.r.emax;
+		tail->estat |= ESTAT_MAX;
+	}
 	return(tail);
 }
 static _force_inline
@@ -1494,140 +2072,153 @@ struct gaba_joint_tail_s *fill_create_tail(
  * @brief load vectors onto registers
  */
 #if MODEL == LINEAR
-#define _fill_load_context(_blk) \
+#define _fill_load_context(_blk, _mstore) \
 	debug("blk(%p)", (_blk)); \
 	/* load sequence buffer offset */ \
 	uint8_t const *aptr = _rd_bufa(self, 0, _W); \
 	uint8_t const *bptr = _rd_bufb(self, 0, _W); \
-	/* load mask pointer */ \
+	/* load mask pointer; masks are not stored if mstore is zero (constant-folded) */ \
 	struct gaba_mask_pair_s *ptr = ((struct gaba_block_s *)(_blk))->mask; \
+	uint64_t const store_mask = (_mstore); \
 	/* load vector registers */ \
-	register nvec_t dh = _loadu_n(((_blk) - 1)->diff.dh); \
-	register nvec_t dv = _loadu_n(((_blk) - 1)->diff.dv); \
-	_print_n(_add_n(dh, _load_ofsh(self->scv))); \
-	_print_n(_add_n(dv, _load_ofsv(self->scv))); \
+	register dvec_t dh = _loadu_d(((_blk) - 1)->diff.dh); \
+	register dvec_t dv = _loadu_d(((_blk) - 1)->diff.dv); \
+	_print_d(_add_d(dh, _load_ofsh(self->scv))); \
+	_print_d(_add_d(dv, _load_ofsv(self->scv))); \
 	/* load delta vectors */ \
-	register nvec_t delta = _zero_n(); \
-	register nvec_t drop = _load_n(self->w.r.xd.drop); \
-	_print_n(drop); \
-	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_n_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
-	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_n_w(delta)), _add_w(_cvt_n_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
+	register dvec_t delta = _zero_d(); \
+	register dvec_t drop = _load_d(self->w.r.xd.drop); \
+	_print_d(drop); \
+	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_d_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
+	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_d_w(delta)), _add_w(_cvt_d_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
 	/* load direction determiner */ \
-	struct gaba_dir_s dir = _dir_init((_blk) - 1);
+	struct gaba_dir_s dir = _dir_init(self, (_blk) - 1);
 #else	/* AFFINE and COMBINED */
-#define _fill_load_context(_blk) \
+#define _fill_load_context(_blk, _mstore) \
 	debug("blk(%p)", (_blk)); \
 	/* load sequence buffer offset */ \
 	uint8_t const *aptr = _rd_bufa(self, 0, _W); \
 	uint8_t const *bptr = _rd_bufb(self, 0, _W); \
-	/* load mask pointer */ \
+	/* load mask pointer; masks are not stored if mstore is zero (constant-folded) */ \
 	struct gaba_mask_pair_s *ptr = ((struct gaba_block_s *)(_blk))->mask; \
+	uint64_t const store_mask = (_mstore); \
 	/* load vector registers */ \
-	register nvec_t dh = _loadu_n(((_blk) - 1)->diff.dh); \
-	register nvec_t dv = _loadu_n(((_blk) - 1)->diff.dv); \
-	register nvec_t de = _loadu_n(((_blk) - 1)->diff.de); \
-	register nvec_t df = _loadu_n(((_blk) - 1)->diff.df); \
-	_print_n(_sub_n(_load_ofsh(self->scv), dh)); \
-	_print_n(_add_n(dv, _load_ofsv(self->scv))); \
-	_print_n(_sub_n(_sub_n(de, dv), _load_adjh(self->scv))); \
-	_print_n(_sub_n(_add_n(df, dh), _load_adjv(self->scv))); \
+	register dvec_t dh = _loadu_d(((_blk) - 1)->diff.dh); \
+	register dvec_t dv = _loadu_d(((_blk) - 1)->diff.dv); \
+	register dvec_t de = _loadu_d(((_blk) - 1)->diff.de); \
+	register dvec_t df = _loadu_d(((_blk) - 1)->diff.df); \
+	_print_d(_sub_d(_load_ofsh(self->scv), dh)); \
+	_print_d(_add_d(dv, _load_ofsv(self->scv))); \
+	_print_d(_sub_d(_sub_d(de, dv), _load_adjh(self->scv))); \
+	_print_d(_sub_d(_add_d(df, dh), _load_adjv(self->scv))); \
 	/* load delta vectors */ \
-	register nvec_t delta = _zero_n(); \
-	register nvec_t drop = _load_n(self->w.r.xd.drop); \
-	_print_n(drop); \
-	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_n_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
-	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_n_w(delta)), _add_w(_cvt_n_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
+	register dvec_t delta = _zero_d(); \
+	register dvec_t drop = _load_d(self->w.r.xd.drop); \
+	_print_d(drop); \
+	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_d_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
+	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_d_w(delta)), _add_w(_cvt_d_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
 	/* load direction determiner */ \
-	struct gaba_dir_s dir = _dir_init((_blk) - 1);
+	struct gaba_dir_s dir = _dir_init(self, (_blk) - 1);
 #endif
 
+/**
+ * @macro _fill_store_mask, _fill_store_lmask
+ * @brief store a mask vector (skipped in the score-only fill)
+ */
+#define _fill_store_mask(_u, _m) { \
+	if(store_mask) { (_u).mask = (_m); } \
+}
+#define _fill_store_lmask(_u, _m) { \
+	if(store_mask) { _lmask_store(_u, _m); } \
+}
+
 /**
  * @macro _fill_body
  * @brief update vectors
  */
 #if MODEL == LINEAR
 #define _fill_body() { \
-	register nvec_t t = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
+	register nvec_t tm = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
 	_print_n(_loadu_n(aptr)); _print_n(_loadu_n(bptr)); \
-	t = _shuf_n(_load_sb(self->scv), t); _print_n(t); \
-	t = _max_n(dh, t); \
-	t = _max_n(dv, t); \
-	ptr->h.mask = _mask_n(_eq_n(t, dv)); \
-	ptr->v.mask = _mask_n(_eq_n(t, dh)); \
-	debug("mask(%lx, %lx)", (uint64_t)ptr->h.all, (uint64_t)ptr->v.all); \
+	register dvec_t t = _shuf_sb_d(self->scv, tm); _print_d(t); \
+	t = _max_d(dh, t); \
+	t = _max_d(dv, t); \
+	_fill_store_mask(ptr->h, _mask_eq_d(t, dv)); \
+	_fill_store_mask(ptr->v, _mask_eq_d(t, dh)); \
+	debug("mask(%lx, %lx)", _lmask_lo64(_lmask_load(ptr->h)), _lmask_lo64(_lmask_load(ptr->v))); \
 	ptr++; \
-	nvec_t _dv = _sub_n(t, dh); \
-	dh = _sub_n(t, dv); \
+	dvec_t _dv = _sub_d(t, dh); \
+	dh = _sub_d(t, dv); \
 	dv = _dv; \
-	_print_n(drop); \
-	_print_n(_add_n(dh, _load_ofsh(self->scv))); \
-	_print_n(_add_n(dv, _load_ofsv(self->scv))); \
+	_print_d(drop); \
+	_print_d(_add_d(dh, _load_ofsh(self->scv))); \
+	_print_d(_add_d(dv, _load_ofsv(self->scv))); \
 }
 #elif MODEL == AFFINE
 #define _fill_body() { \
-	register nvec_t t = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
+	register nvec_t tm = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
 	_print_n(_loadu_n(aptr)); _print_n(_loadu_n(bptr)); \
-	t = _shuf_n(_load_sb(self->scv), t); _print_n(t); \
-	t = _max_n(de, t); \
-	t = _max_n(df, t); \
-	ptr->h.mask = _mask_n(_eq_n(t, de)); \
-	ptr->v.mask = _mask_n(_eq_n(t, df)); \
+	register dvec_t t = _shuf_sb_d(self->scv, tm); _print_d(t); \
+	t = _max_d(de, t); \
+	t = _max_d(df, t); \
+	_fill_store_mask(ptr->h, _mask_eq_d(t, de)); \
+	_fill_store_mask(ptr->v, _mask_eq_d(t, df)); \
 	/* update de and dh */ \
-	de = _add_n(de, _load_adjh(self->scv)); \
-	nvec_t te = _max_n(de, t); \
-	ptr->e.mask = _mask_n(_eq_n(te, t)); \
-	de = _add_n(te, dh); \
-	dh = _add_n(dh, t); \
+	de = _add_d(de, _load_adjh(self->scv)); \
+	dvec_t te = _max_d(de, t); \
+	_fill_store_mask(ptr->e, _mask_eq_d(te, t)); \
+	de = _add_d(te, dh); \
+	dh = _add_d(dh, t); \
 	/* update df and dv */ \
-	df = _add_n(df, _load_adjv(self->scv)); \
-	nvec_t tf = _max_n(df, t); \
-	ptr->f.mask = _mask_n(_eq_n(tf, t)); \
-	debug("mask(%lx, %lx, %lx, %lx)", (uint64_t)ptr->h.all, (uint64_t)ptr->v.all, (uint64_t)ptr->e.all, (uint64_t)ptr->f.all); \
-	df = _sub_n(tf, dv); \
-	t = _sub_n(dv, t); \
+	df = _add_d(df, _load_adjv(self->scv)); \
+	dvec_t tf = _max_d(df, t); \
+	_fill_store_mask(ptr->f, _mask_eq_d(tf, t)); \
+	debug("mask(%lx, %lx, %lx, %lx)", _lmask_lo64(_lmask_load(ptr->h)), _lmask_lo64(_lmask_load(ptr->v)), _lmask_lo64(_lmask_load(ptr->e)), _lmask_lo64(_lmask_load(ptr->f))); \
+	df = _sub_d(tf, dv); \
+	t = _sub_d(dv, t); \
 	ptr++; dv = dh; dh = t; \
-	_print_n(_sub_n(_load_ofsh(self->scv), dh)); \
-	_print_n(_add_n(dv, _load_ofsv(self->scv))); \
-	_print_n(_sub_n(_sub_n(de, dv), _load_adjh(self->scv))); \
-	_print_n(_sub_n(_add_n(df, dh), _load_adjv(self->scv))); \
+	_print_d(_sub_d(_load_ofsh(self->scv), dh)); \
+	_print_d(_add_d(dv, _load_ofsv(self->scv))); \
+	_print_d(_sub_d(_sub_d(de, dv), _load_adjh(self->scv))); \
+	_print_d(_sub_d(_add_d(df, dh), _load_adjv(self->scv))); \
 }
 #else /* MODEL == COMBINED */
 #define _fill_body() { \
-	register nvec_t t = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
-	register nvec_t dfh = _add_n(dv, _load_gfh(self->scv)); \
-	register nvec_t dfv = _sub_n(_load_gfv(self->scv), dh); \
-	_print_n(_sub_n(_zero_n(), dh)); _print_n(dv); _print_n(de); _print_n(df); \
-	_print_n(dfv); _print_n(dfh); \
+	register nvec_t tm = _match_n(_loadu_n(aptr), _loadu_n(bptr)); \
+	register dvec_t dfh = _add_d(dv, _load_gfh(self->scv)); \
+	register dvec_t dfv = _sub_d(_load_gfv(self->scv), dh); \
+	_print_d(_sub_d(_zero_d(), dh)); _print_d(dv); _print_d(de); _print_d(df); \
+	_print_d(dfv); _print_d(dfh); \
 	_print_n(_loadu_n(aptr)); _print_n(_loadu_n(bptr)); \
-	register nvec_t s = _max_n(de, df); \
-	t = _shuf_n(_load_sb(self->scv), t); _print_n(t); \
-	s = _max_n(s, dfh); \
-	t = _max_n(t, dfv); \
-	t = _max_n(t, s); \
-	_print_n(t); \
-	uint64_t mask_gfh = _mask_u64(_mask_n(_eq_n(t, dfh))), mask_gh = _mask_u64(_mask_n(_eq_n(t, de))); \
-	uint64_t mask_gfv = _mask_u64(_mask_n(_eq_n(t, dfv))), mask_gv = _mask_u64(_mask_n(_eq_n(t, df))); \
-	debug("mask_gfh(%lx), mask_gh(%lx), mask_gfv(%lx), mask_gv(%lx)", mask_gfh, mask_gh, mask_gfv, mask_gv); \
-	ptr->h.all = mask_gfh | mask_gh; mask_gh &= ~mask_gfh; \
-	ptr->v.all = mask_gfv | mask_gv; mask_gv &= ~mask_gfv; \
+	register dvec_t s = _max_d(de, df); \
+	register dvec_t t = _shuf_sb_d(self->scv, tm); _print_d(t); \
+	s = _max_d(s, dfh); \
+	t = _max_d(t, dfv); \
+	t = _max_d(t, s); \
+	_print_d(t); \
+	lmask_t mask_gfh = _lmask(_mask_eq_d(t, dfh)), mask_gh = _lmask(_mask_eq_d(t, de)); \
+	lmask_t mask_gfv = _lmask(_mask_eq_d(t, dfv)), mask_gv = _lmask(_mask_eq_d(t, df)); \
+	debug("mask_gfh(%lx), mask_gh(%lx), mask_gfv(%lx), mask_gv(%lx)", _lmask_lo64(mask_gfh), _lmask_lo64(mask_gh), _lmask_lo64(mask_gfv), _lmask_lo64(mask_gv)); \
+	_fill_store_lmask(ptr->h, _lmask_or(mask_gfh, mask_gh)); mask_gh = _lmask_andn(mask_gfh, mask_gh); \
+	_fill_store_lmask(ptr->v, _lmask_or(mask_gfv, mask_gv)); mask_gv = _lmask_andn(mask_gfv, mask_gv); \
 	/* update de and dh */ \
-	de = _add_n(de, _load_adjh(self->scv)); \
-	nvec_t te = _max_n(de, t); \
-	ptr->e.all = mask_gh | _mask_u64(_mask_n(_eq_n(te, t))); \
-	de = _add_n(te, dh); \
-	dh = _add_n(dh, t); \
+	de = _add_d(de, _load_adjh(self->scv)); \
+	dvec_t te = _max_d(de, t); \
+	_fill_store_lmask(ptr->e, _lmask_or(mask_gh, _lmask(_mask_eq_d(te, t)))); \
+	de = _add_d(te, dh); \
+	dh = _add_d(dh, t); \
 	/* update df and dv */ \
-	df = _add_n(df, _load_adjv(self->scv)); \
-	nvec_t tf = _max_n(df, t); \
-	ptr->f.all = mask_gv | _mask_u64(_mask_n(_eq_n(tf, t))); \
-	debug("mask_ge(%lx), mask_gf(%lx), mask(%lx, %lx, %lx, %lx)", (uint64_t)_mask_u64(_mask_n(_eq_n(te, t))), (uint64_t)_mask_u64(_mask_n(_eq_n(tf, t))), (uint64_t)ptr->h.all, (uint64_t)ptr->v.all, (uint64_t)ptr->e.all, (uint64_t)ptr->f.all); \
-	df = _sub_n(tf, dv); \
-	t = _sub_n(dv, t); \
+	df = _add_d(df, _load_adjv(self->scv)); \
+	dvec_t tf = _max_d(df, t); \
+	_fill_store_lmask(ptr->f, _lmask_or(mask_gv, _lmask(_mask_eq_d(tf, t)))); \
+	debug("mask_ge(%lx), mask_gf(%lx), mask(%lx, %lx, %lx, %lx)", _lmask_lo64(_lmask(_mask_eq_d(te, t))), _lmask_lo64(_lmask(_mask_eq_d(tf, t))), _lmask_lo64(_lmask_load(ptr->h)), _lmask_lo64(_lmask_load(ptr->v)), _lmask_lo64(_lmask_load(ptr->e)), _lmask_lo64(_lmask_load(ptr->f))); \
+	df = _sub_d(tf, dv); \
+	t = _sub_d(dv, t); \
 	ptr++; dv = dh; dh = t; \
-	_print_n(_sub_n(_load_ofsh(self->scv), dh)); \
-	_print_n(_add_n(dv, _load_ofsv(self->scv))); \
-	_print_n(_sub_n(_sub_n(de, dv), _load_adjh(self->scv))); \
-	_print_n(_sub_n(_add_n(df, dh), _load_adjv(self->scv))); \
+	_print_d(_sub_d(_load_ofsh(self->scv), dh)); \
+	_print_d(_add_d(dv, _load_ofsv(self->scv))); \
+	_print_d(_sub_d(_sub_d(de, dv), _load_adjh(self->scv))); \
+	_print_d(_sub_d(_add_d(df, dh), _load_adjv(self->scv))); \
 }
 #endif /* MODEL */
 
@@ -1636,13 +2227,13 @@ struct gaba_joint_tail_s *fill_create_tail(
  * @brief update small delta vector and max vector
  */
 #define _fill_update_delta(_op_add, _vector, _ofs) { \
-	nvec_t _t = _op_add(_ofs, _vector); \
-	delta = _add_n(delta, _t); \
-	drop = _subs_n(drop, _t); \
+	dvec_t _t = _op_add(_ofs, _vector); \
+	delta = _add_d(delta, _t); \
+	drop = _subs_d(drop, _t); \
 	_dir_update(dir, _t); \
-	_print_n(delta); _print_n(drop); \
-	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_n_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
-	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_n_w(delta)), _add_w(_cvt_n_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
+	_print_d(delta); _print_d(drop); \
+	_print_w(_add_w(_load_w(&self->w.r.md), _add_w(_cvt_d_w(delta), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd - 128)))); \
+	_print_w(_add_w(_add_w(_load_w(&self->w.r.md), _cvt_d_w(delta)), _add_w(_cvt_d_w(drop), _set_w(_offset(self->w.r.tail) + self->w.r.ofsd)))); \
 }
 /**
  * @macro _fill_right, _fill_down
@@ -1656,16 +2247,16 @@ struct gaba_joint_tail_s *fill_create_tail(
 }
 #if MODEL == LINEAR
 #define _fill_right() { \
-	dh = _bsl_n(dh, 1);	/* shift left dh */ \
+	dh = _bsl_d(dh, 1);	/* shift left dh */ \
 	_fill_body();		/* update vectors */ \
-	_fill_update_delta(_add_n, dh, _load_ofsh(self->scv)); \
+	_fill_update_delta(_add_d, dh, _load_ofsh(self->scv)); \
 }
 #else	/* AFFINE and COMBINED */
 #define _fill_right() { \
-	dh = _bsl_n(dh, 1);	/* shift left dh */ \
-	df = _bsl_n(df, 1);	/* shift left df */ \
+	dh = _bsl_d(dh, 1);	/* shift left dh */ \
+	df = _bsl_d(df, 1);	/* shift left df */ \
 	_fill_body();		/* update vectors */ \
-	_fill_update_delta(_sub_n, dh, _load_ofsh(self->scv)); \
+	_fill_update_delta(_sub_d, dh, _load_ofsh(self->scv)); \
 }
 #endif /* MODEL */
 #define _fill_down_update_ptr() { \
@@ -1676,20 +2267,20 @@ struct gaba_joint_tail_s *fill_create_tail(
 }
 #if MODEL == LINEAR
 #define _fill_down() { \
-	dv = _bsr_n(dv, 1);	/* shift right dv */ \
+	dv = _bsr_d(dv, 1);	/* shift right dv */ \
 	_fill_body();		/* update vectors */ \
-	_fill_update_delta(_add_n, dv, _load_ofsv(self->scv)); \
+	_fill_update_delta(_add_d, dv, _load_ofsv(self->scv)); \
 }
 #else	/* AFFINE and COMBINED */
 #define _fill_down() { \
-	dv = _bsr_n(dv, 1);	/* shift right dv */ \
-	de = _bsr_n(de, 1);	/* shift right de */ \
+	dv = _bsr_d(dv, 1);	/* shift right dv */ \
+	de = _bsr_d(de, 1);	/* shift right de */ \
 	_fill_body();		/* update vectors */ \
-	_fill_update_delta(_add_n, dv, _load_ofsv(self->scv)); \
+	_fill_update_delta(_add_d, dv, _load_ofsv(self->scv)); \
 }
 #endif /* MODEL */
 
-#if defined(DEBUG) || defined(DEBUG_OVERFLOW)
+#if (defined(DEBUG) || defined(DEBUG_OVERFLOW)) && DIFF == 8
 #define _check_overflow(_delta, _drop) { \
 	int8_t b[_W], d[_W], flag = 0; int16_t ovf[_W], udf[_W], m1[_W], m2[_W], m3[_W]; \
 	_storeu_n(b, _delta); _storeu_n(d, _drop); \
@@ -1718,6 +2309,62 @@ struct gaba_joint_tail_s *fill_create_tail(
 #define _check_overflow(_x, _y) {}
 #endif
 
+/**
+ * @macro _fill_rescue_overflow
+ * @brief the 8-bit small delta wraps around in a block; the carry is recovered from the drop vector (no-op in the 16-bit lanes)
+ */
+#if DIFF == 8
+#define _fill_rescue_overflow(_md, _delta, _drop, _cofs) { \
+	_check_overflow(_delta, _drop); \
+	/* rescue overflow */ \
+	(_md) = _add_w((_md), _and_w(_set_w(0x0100), _cvt_n_w(_andn_n(_add_n((_drop), (_delta)), _and_n((_drop), (_delta)))))); \
+	/* rescue underflow */ \
+	(_md) = _add_w((_md), _and_w(_set_w(0x0100), _cvt_n_w(_or_n(_subs_n((_delta), _set_n(0x40)), (_drop))))); (_cofs) += 0x0100; \
+}
+#else
+#define _fill_rescue_overflow(_md, _delta, _drop, _cofs) {}
+#endif
+
+/**
+ * @fn fill_test_zdrop
+ * @brief Z-drop test at the end of a block, evaluated on the best cell of the last vector;
+ * returns TERM | ZDROP if the cell dropped from the max more than tz + ge * (diagonal distance
+ * from the max), CONT otherwise. the max and its diagonal are updated here.
+ */
+static _force_inline
+int8_t fill_test_zdrop(
+	struct gaba_dp_context_s *self)
+{
+	wvec_t md = _load_w(&self->w.r.md);
+	wvec_t mx = _add_w(md, _cvt_d_w(_load_d(&self->w.r.xd)));	/* lanewise max */
+	int64_t ofs = _offset(self->w.r.tail) + self->w.r.ofsd;
+
+	/* diagonal (a - b) of the cell on the lane 0; lane q is on diag - 2q */
+	uint32_t diag = (uint32_t)(self->w.r.tail->f.apos - self->w.r.tail->f.bpos) + _W - 1
+		+ (self->w.r.asridx - self->w.r.arem - self->w.r.arlim)
+		- (self->w.r.bsridx - self->w.r.brem - self->w.r.brlim);
+
+	/* record the diagonal if the max is updated in the block */
+	int32_t mdrop = _hmax_w(mx);
+	if(ofs + mdrop > self->w.r.zmax) {
+		self->w.r.zmax = ofs + mdrop;
+		self->w.r.zdiag = diag - 2 * _lmask_tzcnt(_lmask(_mask_w(_eq_w(mx, _set_w(mdrop)))));
+		return(CONT);
+	}
+
+	/* the band stopped at the end of the section lags behind the max; tested again in the next fill */
+	if(self->w.r.arem == 0 || self->w.r.brem == 0) { return(CONT); }
+
+	/* the current score is md - 128 (xd is -128 on the lanes at their max) */
+	int32_t smax = _hmax_w(md);
+	int64_t drop = self->w.r.zmax - (ofs + smax - 128);
+	if(_likely(drop <= self->tz)) { return(CONT); }		/* no gap term needed */
+
+	int32_t drift = (int32_t)(diag - 2 * _lmask_tzcnt(_lmask(_mask_w(_eq_w(md, _set_w(smax))))) - self->w.r.zdiag);
+	debug("zdrop, max(%ld), drop(%ld), drift(%d)", self->w.r.zmax, drop, drift);
+	return((drop > self->tz - self->ge * (int64_t)(drift < 0 ? -drift : drift)) ? (TERM | ZDROP) : CONT);
+}
+
 /**
  * @macro _fill_store_context
  * @brief store vectors at the end of the block
@@ -1726,44 +2373,45 @@ struct gaba_joint_tail_s *fill_create_tail(
 	/* store direction array */ \
 	_dir_save(_blk, dir); \
 	/* update xdrop status and offsets */ \
-	(_blk)->xstat = (self->tx - _ext_n(drop, _W/2)) & TERM; \
-	int32_t cofs = _ext_n(delta, _W/2); \
+	(_blk)->xstat = _xstat_d(self->tx - _ext_d(drop, _W/2)); \
+	int32_t cofs = _ext_d(delta, _W/2); \
 	/* store cnt */ \
 	int32_t acnt = _rd_bufa(self, 0, _W) - aptr; \
 	int32_t bcnt = bptr - _rd_bufb(self, 0, _W); \
 	(_blk)->acnt = acnt; (_blk)->bcnt = bcnt; \
 	/* write back local working buffers */ \
 	self->w.r.ofsd += cofs; self->w.r.arem -= acnt; self->w.r.brem -= bcnt; \
+	self->w.r.sdrift += acnt - bcnt; \
 	/* update max and middle vectors in the working buffer */ \
-	nvec_t prev_drop = _load_n(&self->w.r.xd); \
-	_store_n(&self->w.r.xd, drop);		/* save max delta vector */ \
-	_print_n(prev_drop); _print_n(_add_n(drop, delta)); \
-	(_blk)->max_mask = _mask_u64(_mask_n(_gt_n(_add_n(drop, delta), prev_drop))); \
-	debug("update_mask(%lx)", (uint64_t)(_blk)->max_mask); \
+	dvec_t prev_drop = _load_d(&self->w.r.xd); \
+	_store_d(&self->w.r.xd, drop);		/* save max delta vector */ \
+	_print_d(prev_drop); _print_d(_add_d(drop, delta)); \
+	(_blk)->max_mask = _lmask(_mask_gt_d(_add_d(drop, delta), prev_drop)); \
+	debug("update_mask(%lx)", _lmask_lo64((_blk)->max_mask)); \
 	/* update middle delta vector */ \
 	wvec_t md = _load_w(&self->w.r.md); \
-	md = _add_w(md, _cvt_n_w(delta)); \
-	_check_overflow(delta, drop); \
-	/* rescue overflow */ \
-	md = _add_w(md, _and_w(_set_w(0x0100), _cvt_n_w(_andn_n(_add_n(drop, delta), _and_n(drop, delta))))); \
-	/* rescue underflow */ \
-	md = _add_w(md, _and_w(_set_w(0x0100), _cvt_n_w(_or_n(_subs_n(delta, _set_n(0x40)), drop)))); cofs += 0x0100; \
+	md = _add_w(md, _cvt_d_w(delta)); \
+	_fill_rescue_overflow(md, delta, drop, cofs); \
 	md = _add_w(md, _set_w(-cofs));		/* fixup offset adjustment */ \
 	_store_w(&self->w.r.md, md); \
 	_print_w(md); \
+	/* Z-drop test (disabled if tz == 0) */ \
+	if(_unlikely(self->tz != 0)) { (_blk)->xstat |= fill_test_zdrop(self); } \
+	/* the next target of GABA_STEER_MAX, the lane q of the best score; the center lane is 2q - _W diagonals off it */ \
+	if(_unlikely(self->steer == GABA_STEER_MAX)) { self->w.r.sdrift = 2 * (int32_t)_lmask_tzcnt(_lmask(_mask_w(_eq_w(md, _set_w(_hmax_w(md)))))) - _W; } \
 }
 #if MODEL == LINEAR
 #define _fill_store_context(_blk) { \
-	_storeu_n((_blk)->diff.dh, dh); _print_n(dh); \
-	_storeu_n((_blk)->diff.dv, dv); _print_n(dv); \
+	_storeu_d((_blk)->diff.dh, dh); _print_d(dh); \
+	_storeu_d((_blk)->diff.dv, dv); _print_d(dv); \
 	_fill_store_context_intl(_blk); \
 }
 #else	/* AFFINE and COMBINED */
 #define _fill_store_context(_blk) { \
-	_storeu_n((_blk)->diff.dh, dh); _print_n(dh); \
-	_storeu_n((_blk)->diff.dv, dv); _print_n(dv); \
-	_storeu_n((_blk)->diff.de, de); _print_n(de); \
-	_storeu_n((_blk)->diff.df, df); _print_n(df); \
+	_storeu_d((_blk)->diff.dh, dh); _print_d(dh); \
+	_storeu_d((_blk)->diff.dv, dv); _print_d(dv); \
+	_storeu_d((_blk)->diff.de, de); _print_d(de); \
+	_storeu_d((_blk)->diff.df, df); _print_d(df); \
 	_fill_store_context_intl(_blk); \
 }
 #endif
@@ -1811,7 +2459,8 @@ int64_t fill_bulk_test_idx(
 static _force_inline
 void fill_bulk_block(
 	struct gaba_dp_context_s *self,
-	struct gaba_block_s *blk)
+	struct gaba_block_s *blk,
+	uint64_t mstore)
 {
 	_test_bar(head); _test_bar(mid); _test_bar(tail);
 	/* fetch sequence */
@@ -1819,7 +2468,7 @@ void fill_bulk_block(
 
 	/* load vectors onto registers */
 	debug("blk(%p)", blk);
-	_fill_load_context(blk);
+	_fill_load_context(blk, mstore);
 	/**
 	 * @macro _fill_block
 	 * @brief unit unrolled fill-in loop
@@ -1850,6 +2499,91 @@ void fill_bulk_block(
 	return;
 }
 
+/**
+ * @macro _fill_dual_decl, _fill_dual_bind, _fill_dual_save
+ * @brief registers of the streams of the dual-stream kernel, suffixed by the stream index.
+ * they are bound to the names used in the single-stream macros (self, dh, dv, ...) in a scope.
+ */
+#if MODEL == LINEAR
+#define _fill_dual_decl_vec(_k)		dvec_t dh##_k, dv##_k;
+#define _fill_dual_bind_vec(_k)		dvec_t dh = dh##_k, dv = dv##_k;
+#define _fill_dual_save_vec(_k)		{ dh##_k = dh; dv##_k = dv; }
+#else	/* AFFINE and COMBINED */
+#define _fill_dual_decl_vec(_k)		dvec_t dh##_k, dv##_k, de##_k, df##_k;
+#define _fill_dual_bind_vec(_k)		dvec_t dh = dh##_k, dv = dv##_k, de = de##_k, df = df##_k;
+#define _fill_dual_save_vec(_k)		{ dh##_k = dh; dv##_k = dv; de##_k = de; df##_k = df; }
+#endif
+#define _fill_dual_decl(_k) \
+	uint8_t const *aptr##_k, *bptr##_k; \
+	struct gaba_mask_pair_s *ptr##_k; \
+	_fill_dual_decl_vec(_k); \
+	dvec_t delta##_k, drop##_k; \
+	struct gaba_dir_s dir##_k;
+#define _fill_dual_bind(_k) \
+	struct gaba_dp_context_s *self = s##_k; (void)self; \
+	uint8_t const *aptr = aptr##_k, *bptr = bptr##_k; \
+	struct gaba_mask_pair_s *ptr = ptr##_k; \
+	uint64_t const store_mask = 1; \
+	_fill_dual_bind_vec(_k); \
+	dvec_t delta = delta##_k, drop = drop##_k; \
+	struct gaba_dir_s dir = dir##_k;
+#define _fill_dual_save(_k) { \
+	aptr##_k = aptr; bptr##_k = bptr; ptr##_k = ptr; \
+	_fill_dual_save_vec(_k); \
+	delta##_k = delta; drop##_k = drop; \
+	dir##_k = dir; \
+}
+
+/**
+ * @macro _fill_dual_step
+ * @brief advance a stream by a vector in the direction (down or right)
+ */
+#define _fill_dual_step(_k, _direction) { \
+	_fill_dual_bind(_k); \
+	_fill_##_direction##_update_ptr(); \
+	_fill_##_direction(); \
+	_fill_dual_save(_k); \
+}
+
+/**
+ * @fn fill_dual_block
+ * @brief fill a pair of blocks of independent extensions in lock-step, without ij-bound test.
+ * the two streams are interleaved vector by vector, so that their dependency chains overlap.
+ */
+static _force_inline
+void fill_dual_block(
+	struct gaba_dp_context_s *s0,
+	struct gaba_dp_context_s *s1,
+	struct gaba_block_s *blk0,
+	struct gaba_block_s *blk1)
+{
+	/* fetch sequences */
+	fill_fetch_core(s0, (blk0 - 1)->acnt, BLK, (blk0 - 1)->bcnt, BLK);
+	fill_fetch_core(s1, (blk1 - 1)->acnt, BLK, (blk1 - 1)->bcnt, BLK);
+
+	/* load vectors onto registers */
+	_fill_dual_decl(0);
+	_fill_dual_decl(1);
+	{ struct gaba_dp_context_s *self = s0; _fill_load_context(blk0, 1); (void)store_mask; _fill_dual_save(0); }
+	{ struct gaba_dp_context_s *self = s1; _fill_load_context(blk1, 1); (void)store_mask; _fill_dual_save(1); }
+
+	/* update diff vectors; each case holds the steps of the both streams in a basic block */
+	for(uint64_t i = 0; i < BLK; i++) {
+		_dir_fetch(dir0); _dir_fetch(dir1);
+		switch(_dir_is_down(dir0) + 2 * _dir_is_down(dir1)) {
+			case 0: _fill_dual_step(0, right); _fill_dual_step(1, right); break;
+			case 1: _fill_dual_step(0, down); _fill_dual_step(1, right); break;
+			case 2: _fill_dual_step(0, right); _fill_dual_step(1, down); break;
+			default: _fill_dual_step(0, down); _fill_dual_step(1, down); break;
+		}
+	}
+
+	/* store vectors */
+	{ _fill_dual_bind(0); (void)ptr; (void)store_mask; self->w.r.pridx -= BLK; _fill_store_context(blk0); }
+	{ _fill_dual_bind(1); (void)ptr; (void)store_mask; self->w.r.pridx -= BLK; _fill_store_context(blk1); }
+	return;
+}
+
 #ifdef REDEFINE_DEBUG
 #  define DEBUG
 #  undef _LOG_H_INCLUDED
@@ -1875,7 +2609,7 @@ struct gaba_block_s *fill_bulk_k_blocks(
 			self->w.r.bsridx - self->w.r.brem - self->w.r.brlim,
 			self->w.r.md.delta[_W/2] + self->w.r.xd.drop[_W/2] + _offset(self->w.r.tail) + self->w.r.ofsd);
 		_print_w(_load_w(self->w.r.md.delta));
-		fill_bulk_block(self, ++blk);
+		fill_bulk_block(self, ++blk, 1);
 	}
 	debug("return, blk(%p), xstat(%x), pridx(%u)", blk, blk->xstat, self->w.r.pridx);
 	return(blk);
@@ -1896,7 +2630,7 @@ struct gaba_block_s *fill_bulk_seq_bounded(
 			self->w.r.asridx - self->w.r.arem - self->w.r.arlim,
 			self->w.r.bsridx - self->w.r.brem - self->w.r.brlim,
 			self->w.r.md.delta[_W/2] + self->w.r.xd.drop[_W/2] + _offset(self->w.r.tail) + self->w.r.ofsd);
-		fill_bulk_block(self, ++blk);
+		fill_bulk_block(self, ++blk, 1);
 	}
 	debug("return, blk(%p), xstat(%x)", blk, blk->xstat);
 	return(blk);
@@ -1909,13 +2643,14 @@ struct gaba_block_s *fill_bulk_seq_bounded(
 #endif
 
 /**
- * @fn fill_cap_seq_bounded
- * @brief fill blocks with cap test
+ * @fn fill_cap_block
+ * @brief fill a block with cap test, returns #filled vectors
  */
 static _force_inline
-struct gaba_block_s *fill_cap_seq_bounded(
+uint64_t fill_cap_block(
 	struct gaba_dp_context_s *self,
-	struct gaba_block_s *blk)
+	struct gaba_block_s *blk,
+	uint64_t mstore)
 {
 	_test_bar(head); _test_bar(mid); _test_bar(tail);
 	#define _fill_cap_seq_bounded_core(_dir) { \
@@ -1929,29 +2664,43 @@ struct gaba_block_s *fill_cap_seq_bounded(
 		_fill_##_dir();		/* update band */ \
 	}
 
-	debug("blk(%p)", blk);
-	while(blk->xstat >= 0) {
-		/* fetch sequence */
-		fill_cap_fetch(self, ++blk);
-		_fill_cap_test_idx_init();
-		_fill_load_context(blk);			/* contains ptr as struct gaba_mask_pair_s *ptr = blk->mask; */
-
-		/* update diff vectors */
-		struct gaba_mask_pair_s *tptr = &blk->mask[BLK];
-		while(ptr < tptr) {					/* ptr is automatically incremented in _fill_right() or _fill_down() */
-			_dir_fetch(dir);				/* determine direction */
-			if(_dir_is_right(dir)) {
-				_fill_cap_seq_bounded_core(right);
-			} else {
-				_fill_cap_seq_bounded_core(down);
-			}
+	/* fetch sequence */
+	fill_cap_fetch(self, blk);
+	_fill_cap_test_idx_init();
+	_fill_load_context(blk, mstore);	/* contains ptr as struct gaba_mask_pair_s *ptr = blk->mask; */
+
+	/* update diff vectors */
+	struct gaba_mask_pair_s *tptr = &blk->mask[BLK];
+	while(ptr < tptr) {					/* ptr is automatically incremented in _fill_right() or _fill_down() */
+		_dir_fetch(dir);				/* determine direction */
+		if(_dir_is_right(dir)) {
+			_fill_cap_seq_bounded_core(right);
+		} else {
+			_fill_cap_seq_bounded_core(down);
 		}
+	}
 
-		uint64_t i = ptr - blk->mask;		/* calc filled count */
-		self->w.r.pridx -= i;				/* update remaining p-length */
-		_dir_adjust_remainder(dir, i);		/* adjust dir remainder */
-		_fill_store_context(blk);			/* store mask and vectors */
-		if(_unlikely(i != BLK)) { break; }	/* reached the end */
+	uint64_t i = ptr - blk->mask;		/* calc filled count */
+	self->w.r.pridx -= i;				/* update remaining p-length */
+	_dir_adjust_remainder(dir, i);		/* adjust dir remainder */
+	_fill_store_context(blk);			/* store mask and vectors */
+	return(i);
+
+	#undef _fill_cap_seq_bounded_core
+}
+
+/**
+ * @fn fill_cap_seq_bounded
+ * @brief fill blocks with cap test
+ */
+static _force_inline
+struct gaba_block_s *fill_cap_seq_bounded(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	debug("blk(%p)", blk);
+	while(blk->xstat >= 0) {
+		if(_unlikely(fill_cap_block(self, ++blk, 1) != BLK)) { break; }	/* reached the end */
 	}
 	debug("return, blk(%p), xstat(%x)", blk, blk->xstat);
 	return(blk);
@@ -2068,59 +2817,698 @@ struct gaba_block_s *fill_section_seq_bounded(
 }
 
 /**
- * @fn gaba_dp_fill_root
- *
- * @brief build_root API
+ * @fn fill_score_wrap
+ * @brief rewind the block pointer to the head of the ring when it reached the end.
+ * the phantom part of the last block is copied to the head, and the max block
+ * (with its previous block) is evacuated to the pair of blocks before the ring.
  */
-struct gaba_fill_s *_export(gaba_dp_fill_root)(
+static _force_inline
+struct gaba_block_s *fill_score_wrap(
 	struct gaba_dp_context_s *self,
-	struct gaba_section_s const *a,
-	uint32_t apos,
-	struct gaba_section_s const *b,
-	uint32_t bpos,
-	uint32_t pridx)
+	struct gaba_block_s *rblk,
+	struct gaba_block_s *blk)
 {
-	/* restore dp context pointer by adding offset */
-	self = _restore_dp_context(self);
-	_init_bar(head); _init_bar(mid); _init_bar(tail);
-
-	/* load current sections, then transpose sections to extract {id, len, base} pairs */
-	v2i64_t asec = _loadu_v2i64(a), bsec = _loadu_v2i64(b);	/* tuple of (64bit ptr, 32-bit id, 32-bit len) */
-	v2i64_t id_len = _lo_v2i64(asec, bsec), bptr = _hi_v2i64(asec, bsec);
-	v2i32_t id = _cvt_v2i64_v2i32(id_len), len = _cvth_v2i64_v2i32(id_len);
-	v2i32_t adv = _seta_v2i32(bpos, apos);		/* head offsets */
-	_print_v2i32(id); _print_v2i32(len); _print_v2i64(bptr); _print_v2i32(adv);
-
-	/* create bridge (skip (apos, bpos) at the head) */
-	struct gaba_joint_tail_s *brg = fill_create_bridge(self, _root(self), id, len, bptr, adv);
-
-	/* load sections */
-	fill_load_section(self,
-		brg, id, len, bptr,
-		pridx == 0 ? UINT32_MAX : pridx			/* UINT32_MAX */
-	);
-
-	/* load sequences and extract the last block pointer */
-	if(_stack_size(&self->stack) < MEM_INIT_VACANCY) {
-		gaba_dp_add_stack(self, _mem_blocks(max_blocks_idx(self)));
-	}
-	struct gaba_block_s *blk = fill_load_vectors(self, _root(self));
-
-	/* init fetch */
-	if(fill_init_fetch(self, blk, _load_v2i64(&_root(self)->f.apos)) < INIT_FETCH_BPOS) {
-		return(_fill(fill_create_tail(self, blk)));
+	if(_likely(blk != rblk + SCORE_RING_BLOCKS)) { return(blk); }
+
+	/* C1 is placed just before the phantom, and C0 before C1 */
+	struct gaba_block_s *cblk = (struct gaba_block_s *)_phantom(rblk) - 1;
+	struct gaba_block_s const *mblk = self->w.r.mblk;
+	if(mblk > rblk && mblk <= blk) {
+		*_phantom(cblk - 1) = *_phantom(mblk - 1);
+		*_phantom(cblk) = *_phantom(mblk);
+		self->w.r.mblk = cblk;
 	}
+	debug("wrap, rblk(%p), blk(%p), mblk(%p)", rblk, blk, self->w.r.mblk);
 
-	/* init fetch done, issue ungapped extension here if filter is needed */
-	/* fill blocks then create a tail cap */
-	return(_fill(fill_create_tail(self,
-		fill_section_seq_bounded(self, blk)
-	)));
+	/* copy the last block to the head */
+	*_phantom(rblk) = *_phantom(blk);
+	return(rblk);
 }
 
 /**
- * @fn gaba_dp_fill
- *
+ * @fn fill_score_update_max
+ * @brief record the block if the max score is updated in the block
+ */
+static _force_inline
+void fill_score_update_max(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	if(_likely(_lmask_is_zero(blk->max_mask))) { return; }
+
+	/* calc max of the band (same as fill_save_vectors) */
+	wvec_t md = _add_w(_load_w(&self->w.r.md), _cvt_d_w(_load_d(&self->w.r.xd)));
+	int32_t mdrop = _hmax_w(md);
+	int64_t max = _offset(self->w.r.tail) + self->w.r.ofsd + mdrop;
+	if(max <= self->w.r.mmax) { return; }
+
+	/* update the max block; lanes holding the max are kept in the max_mask */
+	self->w.r.mmax = max;
+	self->w.r.mblk = blk;
+	blk->max_mask = _lmask(_mask_w(_eq_w(md, _set_w(mdrop))));
+	_store_v2i64(&self->w.r.mapos, _add_v2i64(
+		_load_v2i64(&self->w.r.tail->f.apos),
+		_cvt_v2i32_v2i64(_sub_v2i32(
+			_load_v2i32(&self->w.r.asridx),
+			_add_v2i32(_load_v2i32(&self->w.r.arem), _load_v2i32(&self->w.r.arlim))
+		))
+	));
+	debug("max updated, blk(%p), max(%ld), max_mask(%lx)", blk, max, _lmask_lo64(blk->max_mask));
+	return;
+}
+
+/**
+ * @fn fill_score_seq_bounded
+ * @brief score-only fill; masks are not stored and blocks are recycled in a ring
+ */
+static _force_inline
+struct gaba_block_s *fill_score_seq_bounded(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	struct gaba_block_s *rblk = blk;	/* head of the ring (phantom) */
+
+	/* bulk fill with ij-bound test */
+	while((blk->xstat | fill_bulk_test_idx(self)) >= 0) {
+		blk = fill_score_wrap(self, rblk, blk);
+		fill_bulk_block(self, ++blk, 0);
+		fill_score_update_max(self, blk);
+	}
+	if((blk->xstat & STAT_MASK) != CONT) {
+		debug("term detected, blk(%p), xstat(%x)", blk, blk->xstat);
+		return(blk);					/* xdrop termination detected, skip cap */
+	}
+
+	/* cap fill */
+	while(blk->xstat >= 0) {
+		blk = fill_score_wrap(self, rblk, blk);
+		uint64_t i = fill_cap_block(self, ++blk, 0);
+		fill_score_update_max(self, blk);
+		if(_unlikely(i != BLK)) { break; }
+	}
+	debug("return, blk(%p), xstat(%x)", blk, blk->xstat);
+	return(blk);
+}
+
+/**
+ * @fn fill_score_load_vectors
+ * @brief reserve the ring (and the pair of blocks for the max block) then load vectors
+ */
+static _force_inline
+struct gaba_block_s *fill_score_load_vectors(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail)
+{
+	if(_stack_size(&self->stack) < MEM_SCORE_VACANCY) {
+		gaba_dp_add_stack(self, MEM_SCORE_VACANCY);
+	}
+	self->stack.top += 2 * sizeof(struct gaba_block_s);
+	return(fill_load_vectors(self, tail));
+}
+
+/**
+ * @fn fill_global_rem
+ * @brief remaining lengths from the center of the band to the end cell of the global fill, (ra, rb)
+ */
+static _force_inline
+v2i64_t fill_global_rem(
+	struct gaba_dp_context_s const *self)
+{
+	v2i64_t pos = _add_v2i64(
+		_load_v2i64(&self->w.r.tail->f.apos),
+		_cvt_v2i32_v2i64(_sub_v2i32(
+			_load_v2i32(&self->w.r.asridx),
+			_add_v2i32(_load_v2i32(&self->w.r.arem), _load_v2i32(&self->w.r.arlim))
+		))
+	);
+	return(_sub_v2i64(_load_v2i64(&self->gapos), pos));
+}
+
+/**
+ * @fn fill_global_bulk_blocks
+ * @brief fill <cnt> blocks with fill_bulk_k_blocks, continuing over the blocks marked by X-drop
+ */
+static _force_inline
+struct gaba_block_s *fill_global_bulk_blocks(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk,
+	uint64_t cnt)
+{
+	struct gaba_block_s *tblk = blk + cnt;
+	while((blk = fill_bulk_k_blocks(self, blk, tblk - blk))->xstat != CONT) {
+		blk->xstat = CONT;				/* no termination in the global fill */
+	}
+	return(blk);
+}
+
+/**
+ * @fn fill_global_block
+ * @brief fill a block steering the band to the end cell, returns #filled vectors. the band follows
+ * the scores until its center reaches one of the ends, then goes straight along the other sequence.
+ * stops at the vector containing the end cell (the center lane, or the one next to it).
+ */
+static _force_inline
+uint64_t fill_global_block(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	_test_bar(head); _test_bar(mid); _test_bar(tail);
+	#define _fill_global_core(_dir) { \
+		_fill_##_dir##_update_ptr(); \
+		if(_fill_cap_test_idx() < 0) { \
+			_fill_##_dir##_windback_ptr(); \
+			_dir_windback(dir); \
+			break; \
+		} \
+		_fill_##_dir();		/* update band */ \
+	}
+
+	/* fetch sequence */
+	v2i64_t rem = fill_global_rem(self);
+	fill_cap_fetch(self, blk);
+	_fill_cap_test_idx_init();
+	_fill_load_context(blk, 1);
+	uint8_t const *ahead = aptr, *bhead = bptr;
+
+	/* update diff vectors */
+	struct gaba_mask_pair_s *tptr = &blk->mask[BLK];
+	while(ptr < tptr) {
+		int64_t ra = _lo64(rem) - (ahead - aptr), rb = _hi64(rem) - (bptr - bhead);
+		if(ra + rb <= 1) { break; }		/* the last vector is on the end cell */
+		_dir_fetch(dir);
+		if(ra == 0) { dir.mask |= 0x01; }	/* reached the end of a, go down */
+		if(rb == 0) { dir.mask &= ~0x01; }	/* reached the end of b, go right */
+		if(_dir_is_right(dir)) {
+			_fill_global_core(right);
+		} else {
+			_fill_global_core(down);
+		}
+	}
+
+	uint64_t i = ptr - blk->mask;		/* calc filled count */
+	self->w.r.pridx -= i;				/* update remaining p-length */
+	_dir_adjust_remainder(dir, i);		/* adjust dir remainder */
+	_fill_store_context(blk);			/* store mask and vectors */
+	blk->xstat = CONT;
+	return(i);
+
+	#undef _fill_global_core
+}
+
+/**
+ * @fn fill_global_seq_bounded
+ * @brief fill blocks toward the end cell of the global fill (gaba_dp_align_global), without X-drop termination
+ */
+static _force_inline
+struct gaba_block_s *fill_global_seq_bounded(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	/* reserve the blocks to the end cell at once; the band advances ra + rb by one on each vector */
+	v2i64_t rem = fill_global_rem(self);
+	uint64_t cnt = (_lo64(rem) + _hi64(rem)) / BLK + 1;
+	if(max_blocks_mem(self) < cnt) {
+		if(gaba_dp_add_stack(self, _mem_blocks(cnt)) != 0) { return(NULL); }
+		blk = fill_create_phantom(self, blk, _load_v2i8(&blk->acnt));
+	}
+
+	/* bulk fill while neither of the ends is in reach of the center of the band */
+	while((cnt = MIN2(min_blocks_idx(self), (uint64_t)MIN2(_lo64(rem), _hi64(rem)) / BLK)) > 0) {
+		blk = fill_global_bulk_blocks(self, blk, cnt);
+		rem = fill_global_rem(self);
+	}
+
+	/* steer the band vector by vector */
+	while(fill_global_block(self, ++blk) == BLK) {}
+	debug("return, blk(%p), xstat(%x)", blk, blk->xstat);
+	return(blk);
+}
+
+/**
+ * @fn fill_end_lanes
+ * @brief lanes on the last column of a and the last row of b of the terminal sections, (qb, qa) at
+ * (apos, bpos); out of [0, _W) if the line is not in the band
+ */
+static _force_inline
+v2i64_t fill_end_lanes(
+	struct gaba_dp_context_s const *self,
+	int64_t apos,
+	int64_t bpos)
+{
+	/* lane 0 was on the column at eapos, and the band shifts it by one on every move to the right */
+	return(_seta_v2i64(self->w.r.ebpos - bpos + _W - 1, apos - self->w.r.eapos));
+}
+
+/**
+ * @fn fill_end_in_reach
+ * @brief non-zero if the last column or row of a terminal section is in the band at the head of the next block
+ */
+static _force_inline
+uint64_t fill_end_in_reach(
+	struct gaba_dp_context_s const *self)
+{
+	v2i64_t pos = _add_v2i64(
+		_load_v2i64(&self->w.r.tail->f.apos),
+		_cvt_v2i32_v2i64(_sub_v2i32(
+			_load_v2i32(&self->w.r.asridx),
+			_add_v2i32(_load_v2i32(&self->w.r.arem), _load_v2i32(&self->w.r.arlim))
+		))
+	);
+	v2i64_t q = fill_end_lanes(self, _lo64(pos), _hi64(pos));
+	return((uint64_t)_lo64(q) < _W || (uint64_t)_hi64(q) < _W);
+}
+
+/**
+ * @fn fill_end_block
+ * @brief fill a block with cap test, evaluating the cells on the last column and row of the terminal
+ * sections with the end bonus on every vector. returns #filled vectors.
+ */
+static _force_inline
+uint64_t fill_end_block(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	_test_bar(head); _test_bar(mid); _test_bar(tail);
+	#define _fill_end_core(_dir) { \
+		_fill_##_dir##_update_ptr(); \
+		if(_fill_cap_test_idx() < 0) { \
+			_fill_##_dir##_windback_ptr(); \
+			_dir_windback(dir); \
+			break; \
+		} \
+		_fill_##_dir();		/* update band */ \
+	}
+
+	/* positions and the score offset at the head of the block */
+	v2i64_t pos = _add_v2i64(
+		_load_v2i64(&self->w.r.tail->f.apos),
+		_cvt_v2i32_v2i64(_sub_v2i32(
+			_load_v2i32(&self->w.r.asridx),
+			_add_v2i32(_load_v2i32(&self->w.r.arem), _load_v2i32(&self->w.r.arlim))
+		))
+	);
+	int64_t const ofs = _offset(self->w.r.tail) + self->w.r.ofsd - 128 + self->tb;
+	wvec_t const md = _load_w(&self->w.r.md);
+
+	/* fetch sequence */
+	fill_cap_fetch(self, blk);
+	_fill_cap_test_idx_init();
+	_fill_load_context(blk, 1);
+	uint8_t const *ahead = aptr, *bhead = bptr;
+
+	/* update diff vectors */
+	struct gaba_mask_pair_s *tptr = &blk->mask[BLK];
+	while(ptr < tptr) {
+		_dir_fetch(dir);
+		if(_dir_is_right(dir)) {
+			_fill_end_core(right);
+		} else {
+			_fill_end_core(down);
+		}
+
+		/* middle delta of the current vector, as updated in _fill_store_context */
+		v2i64_t q = fill_end_lanes(self, _lo64(pos) + (ahead - aptr), _hi64(pos) + (bptr - bhead));
+		if((uint64_t)_lo64(q) >= _W && (uint64_t)_hi64(q) >= _W) { continue; }
+		int32_t cofs = 0;
+		wvec_t v = _add_w(md, _cvt_d_w(delta));
+		_fill_rescue_overflow(v, delta, drop, cofs);
+		int16_t d[_W];
+		_storeu_w(d, v);
+
+		uint64_t const qs[2] = { _lo64(q), _hi64(q) };
+		for(uint64_t j = 0; j < 2; j++) {
+			if(qs[j] >= _W || ofs + d[qs[j]] - cofs <= self->w.r.emax) { continue; }
+			self->w.r.emax = ofs + d[qs[j]] - cofs;
+			self->w.r.eblk = blk;
+			self->w.r.epq = _estat(ptr - blk->mask - 1, qs[j]);
+			debug("end cell updated, blk(%p), p(%ld), q(%lu), emax(%ld)", blk, ptr - blk->mask - 1, qs[j], self->w.r.emax);
+		}
+	}
+
+	uint64_t i = ptr - blk->mask;		/* calc filled count */
+	self->w.r.pridx -= i;				/* update remaining p-length */
+	_dir_adjust_remainder(dir, i);		/* adjust dir remainder */
+	_fill_store_context(blk);			/* store mask and vectors */
+	return(i);
+
+	#undef _fill_end_core
+}
+
+/**
+ * @fn fill_end_seq_bounded
+ * @brief fill blocks vector by vector while the last column or row of a terminal section is in the
+ * band, then continue with the bulk fill
+ */
+static _force_inline
+struct gaba_block_s *fill_end_seq_bounded(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	while(blk->xstat >= 0 && fill_end_in_reach(self)) {
+		if(max_blocks_mem(self) == 0) {
+			if(gaba_dp_add_stack(self, _mem_blocks(max_blocks_idx(self))) != 0) { return(NULL); }
+			blk = fill_create_phantom(self, blk, _load_v2i8(&blk->acnt));
+		}
+		if(_unlikely(fill_end_block(self, ++blk) != BLK)) { return(blk); }	/* reached the end */
+	}
+	debug("return, blk(%p), xstat(%x)", blk, blk->xstat);
+	return(blk->xstat < 0 ? blk : fill_section_seq_bounded(self, blk));
+}
+
+/* the pair kernel of the batch fill: two 16-cell bands are packed in the halves of a 32-cell vector (8-bit lanes only) */
+#if _W == 16 && DIFF == 8
+/**
+ * @val pack_dir_sel
+ * @brief lane group selectors indexed by the direction pair, all ones in the halves going down
+ */
+static int8_t const pack_dir_sel[4][2 * _W] __attribute__(( aligned(32) )) = {
+	{  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0 },
+	{  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0,  0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 },
+	{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 }
+};
+
+/**
+ * @macro _fill_pack_load, _fill_pack_store_mask
+ * @brief load a pair of vectors onto a register, and split a mask into the two blocks
+ */
+#define _fill_pack_load(_p0, _p1)	( _cat_v16i8_v32i8(_loadu_v16i8(_p0), _loadu_v16i8(_p1)) )
+#define _fill_pack_mask(_m)			( ((v32_masku_t){ .mask = (_m) }).all )
+#define _fill_pack_store_mask(_label, _m) { \
+	uint32_t _pm = (_m); \
+	ptr0->_label.all = _pm; ptr1->_label.all = _pm>>16; \
+}
+
+/**
+ * @macro _fill_pack_load_context
+ * @brief load vectors of the pair of blocks onto registers
+ */
+#if MODEL == LINEAR
+#define _fill_pack_load_context(_blk0, _blk1) \
+	_fill_pack_load_context_intl(_blk0, _blk1); \
+	register v32i8_t pdh = _fill_pack_load(((_blk0) - 1)->diff.dh, ((_blk1) - 1)->diff.dh); \
+	register v32i8_t pdv = _fill_pack_load(((_blk0) - 1)->diff.dv, ((_blk1) - 1)->diff.dv);
+#else	/* AFFINE and COMBINED */
+#define _fill_pack_load_context(_blk0, _blk1) \
+	_fill_pack_load_context_intl(_blk0, _blk1); \
+	register v32i8_t pdh = _fill_pack_load(((_blk0) - 1)->diff.dh, ((_blk1) - 1)->diff.dh); \
+	register v32i8_t pdv = _fill_pack_load(((_blk0) - 1)->diff.dv, ((_blk1) - 1)->diff.dv); \
+	register v32i8_t pde = _fill_pack_load(((_blk0) - 1)->diff.de, ((_blk1) - 1)->diff.de); \
+	register v32i8_t pdf = _fill_pack_load(((_blk0) - 1)->diff.df, ((_blk1) - 1)->diff.df);
+#endif
+#define _fill_pack_load_context_intl(_blk0, _blk1) \
+	/* load sequence buffer offsets and mask pointers */ \
+	uint8_t const *aptr0 = _rd_bufa(s0, 0, _W), *bptr0 = _rd_bufb(s0, 0, _W); \
+	uint8_t const *aptr1 = _rd_bufa(s1, 0, _W), *bptr1 = _rd_bufb(s1, 0, _W); \
+	struct gaba_mask_pair_s *ptr0 = (_blk0)->mask, *ptr1 = (_blk1)->mask; \
+	/* load score vectors (shared by the pair) */ \
+	v32i8_t const sb = _from_v16i8_v32i8(_load_sb(s0->scv)); \
+	v32i8_t const adjh = _from_v16i8_v32i8(_load_adjh(s0->scv)), adjv = _from_v16i8_v32i8(_load_adjv(s0->scv)); \
+	v32i8_t const ofsh = _from_v16i8_v32i8(_load_ofsh(s0->scv)), ofsv = _from_v16i8_v32i8(_load_ofsv(s0->scv)); \
+	(void)adjh; (void)adjv; \
+	/* load delta vectors and direction determiners */ \
+	register v32i8_t pdelta = _zero_v32i8(); \
+	register v32i8_t pdrop = _cat_v16i8_v32i8(_load_v16i8(s0->w.r.xd.drop), _load_v16i8(s1->w.r.xd.drop)); \
+	struct gaba_dir_s dir0 = _dir_init(s0, (_blk0) - 1), dir1 = _dir_init(s1, (_blk1) - 1);
+
+/**
+ * @macro _fill_pack_body
+ * @brief update the pair of vectors (same as _fill_body)
+ */
+#if MODEL == LINEAR
+#define _fill_pack_body() { \
+	register v32i8_t t = _match_v32i8(_fill_pack_load(aptr0, aptr1), _fill_pack_load(bptr0, bptr1)); \
+	t = _shuf_v32i8(sb, t); \
+	t = _max_v32i8(pdh, t); \
+	t = _max_v32i8(pdv, t); \
+	_fill_pack_store_mask(h, _fill_pack_mask(_mask_eq_v32i8(t, pdv))); \
+	_fill_pack_store_mask(v, _fill_pack_mask(_mask_eq_v32i8(t, pdh))); \
+	ptr0++; ptr1++; \
+	v32i8_t _dv = _sub_v32i8(t, pdh); \
+	pdh = _sub_v32i8(t, pdv); \
+	pdv = _dv; \
+}
+#elif MODEL == AFFINE
+#define _fill_pack_body() { \
+	register v32i8_t t = _match_v32i8(_fill_pack_load(aptr0, aptr1), _fill_pack_load(bptr0, bptr1)); \
+	t = _shuf_v32i8(sb, t); \
+	t = _max_v32i8(pde, t); \
+	t = _max_v32i8(pdf, t); \
+	_fill_pack_store_mask(h, _fill_pack_mask(_mask_eq_v32i8(t, pde))); \
+	_fill_pack_store_mask(v, _fill_pack_mask(_mask_eq_v32i8(t, pdf))); \
+	/* update de and dh */ \
+	pde = _add_v32i8(pde, adjh); \
+	v32i8_t te = _max_v32i8(pde, t); \
+	_fill_pack_store_mask(e, _fill_pack_mask(_mask_eq_v32i8(te, t))); \
+	pde = _add_v32i8(te, pdh); \
+	pdh = _add_v32i8(pdh, t); \
+	/* update df and dv */ \
+	pdf = _add_v32i8(pdf, adjv); \
+	v32i8_t tf = _max_v32i8(pdf, t); \
+	_fill_pack_store_mask(f, _fill_pack_mask(_mask_eq_v32i8(tf, t))); \
+	pdf = _sub_v32i8(tf, pdv); \
+	t = _sub_v32i8(pdv, t); \
+	ptr0++; ptr1++; pdv = pdh; pdh = t; \
+}
+#else /* MODEL == COMBINED */
+#define _fill_pack_body() { \
+	register v32i8_t t = _match_v32i8(_fill_pack_load(aptr0, aptr1), _fill_pack_load(bptr0, bptr1)); \
+	register v32i8_t dfh = _add_v32i8(pdv, gfh); \
+	register v32i8_t dfv = _sub_v32i8(gfv, pdh); \
+	register v32i8_t s = _max_v32i8(pde, pdf); \
+	t = _shuf_v32i8(sb, t); \
+	s = _max_v32i8(s, dfh); \
+	t = _max_v32i8(t, dfv); \
+	t = _max_v32i8(t, s); \
+	uint32_t mask_gfh = _fill_pack_mask(_mask_eq_v32i8(t, dfh)), mask_gh = _fill_pack_mask(_mask_eq_v32i8(t, pde)); \
+	uint32_t mask_gfv = _fill_pack_mask(_mask_eq_v32i8(t, dfv)), mask_gv = _fill_pack_mask(_mask_eq_v32i8(t, pdf)); \
+	_fill_pack_store_mask(h, mask_gfh | mask_gh); mask_gh &= ~mask_gfh; \
+	_fill_pack_store_mask(v, mask_gfv | mask_gv); mask_gv &= ~mask_gfv; \
+	/* update de and dh */ \
+	pde = _add_v32i8(pde, adjh); \
+	v32i8_t te = _max_v32i8(pde, t); \
+	_fill_pack_store_mask(e, mask_gh | _fill_pack_mask(_mask_eq_v32i8(te, t))); \
+	pde = _add_v32i8(te, pdh); \
+	pdh = _add_v32i8(pdh, t); \
+	/* update df and dv */ \
+	pdf = _add_v32i8(pdf, adjv); \
+	v32i8_t tf = _max_v32i8(pdf, t); \
+	_fill_pack_store_mask(f, mask_gv | _fill_pack_mask(_mask_eq_v32i8(tf, t))); \
+	pdf = _sub_v32i8(tf, pdv); \
+	t = _sub_v32i8(pdv, t); \
+	ptr0++; ptr1++; pdv = pdh; pdh = t; \
+}
+#endif /* MODEL */
+
+/**
+ * @macro _fill_pack_shift, _fill_pack_delta
+ * @brief shift the vectors of the halves going right (dh and df) or down (dv and de), and
+ * calculate the update of the small delta vectors; _dsel is all ones in the halves going down
+ */
+#if MODEL == LINEAR
+#define _fill_pack_shift(_dsel) { \
+	pdh = _sel_v32i8(_bslg_v32i8(pdh), pdh, _dsel); \
+	pdv = _sel_v32i8(pdv, _bsrg_v32i8(pdv), _dsel); \
+}
+#define _fill_pack_delta(_dsel)		( _sel_v32i8(_add_v32i8(ofsh, pdh), _add_v32i8(ofsv, pdv), _dsel) )
+#else	/* AFFINE and COMBINED */
+#define _fill_pack_shift(_dsel) { \
+	pdh = _sel_v32i8(_bslg_v32i8(pdh), pdh, _dsel); \
+	pdf = _sel_v32i8(_bslg_v32i8(pdf), pdf, _dsel); \
+	pdv = _sel_v32i8(pdv, _bsrg_v32i8(pdv), _dsel); \
+	pde = _sel_v32i8(pde, _bsrg_v32i8(pde), _dsel); \
+}
+#define _fill_pack_delta(_dsel)		( _sel_v32i8(_sub_v32i8(ofsh, pdh), _add_v32i8(ofsv, pdv), _dsel) )
+#endif
+
+/**
+ * @macro _fill_pack_store_context
+ * @brief split the pair of vectors, then store them to the block of each lane (with _fill_store_context)
+ */
+#if MODEL == LINEAR
+#define _fill_pack_split(_half) \
+	nvec_t dh = _half##_v16i8_v32i8(pdh), dv = _half##_v16i8_v32i8(pdv);
+#else
+#define _fill_pack_split(_half) \
+	nvec_t dh = _half##_v16i8_v32i8(pdh), dv = _half##_v16i8_v32i8(pdv); \
+	nvec_t de = _half##_v16i8_v32i8(pde), df = _half##_v16i8_v32i8(pdf);
+#endif
+#define _fill_pack_store_context(_self, _blk, _dir, _aptr, _bptr, _half) { \
+	struct gaba_dp_context_s *self = (_self); \
+	struct gaba_dir_s dir = (_dir); \
+	uint8_t const *aptr = (_aptr), *bptr = (_bptr); \
+	_fill_pack_split(_half); \
+	nvec_t delta = _half##_v16i8_v32i8(pdelta), drop = _half##_v16i8_v32i8(pdrop); \
+	self->w.r.pridx -= BLK; \
+	_fill_store_context(_blk); \
+}
+
+#ifndef DEBUG_ALL
+#  undef DEBUG
+#  undef _LOG_H_INCLUDED
+#  include "log.h"
+#endif
+
+/**
+ * @fn fill_pack_block
+ * @brief fill a pair of blocks of independent extensions in lock-step, without ij-bound test
+ */
+static _force_inline
+void fill_pack_block(
+	struct gaba_dp_context_s *s0,
+	struct gaba_dp_context_s *s1,
+	struct gaba_block_s *blk0,
+	struct gaba_block_s *blk1)
+{
+	/* fetch sequences */
+	fill_fetch_core(s0, (blk0 - 1)->acnt, BLK, (blk0 - 1)->bcnt, BLK);
+	fill_fetch_core(s1, (blk1 - 1)->acnt, BLK, (blk1 - 1)->bcnt, BLK);
+
+	/* load vectors onto registers */
+	_fill_pack_load_context(blk0, blk1);
+	#if MODEL == COMBINED
+	v32i8_t const gfh = _from_v16i8_v32i8(_load_gfh(s0->scv)), gfv = _from_v16i8_v32i8(_load_gfv(s0->scv));
+	#endif
+
+	/**
+	 * @macro _fill_pack_step
+	 * @brief update the pair of vectors in the direction pair _d; the selector is a constant in each
+	 * case of the switch below, so that the direction is not on the dependency chain of the vectors
+	 * (the branch is predicted as in the single-band kernel)
+	 */
+	#define _fill_pack_step(_d) { \
+		/* the pointers are updated before the body as in _fill_right and _fill_down */ \
+		v32i8_t const dsel = _load_v32i8(pack_dir_sel[_d]); \
+		aptr0 -= 1 - ((_d) & 0x01); bptr0 += (_d) & 0x01; \
+		aptr1 -= 1 - ((_d)>>1); bptr1 += (_d)>>1; \
+		/* update vectors */ \
+		_fill_pack_shift(dsel); \
+		_fill_pack_body(); \
+		/* update delta vectors and direction determiners */ \
+		v32i8_t _t = _fill_pack_delta(dsel); \
+		pdelta = _add_v32i8(pdelta, _t); \
+		pdrop = _subs_v32i8(pdrop, _t); \
+		dir0.acc += _ext_v32i8(_t, 0) - _ext_v32i8(_t, _W - 1); \
+		dir1.acc += _ext_v32i8(_t, _W) - _ext_v32i8(_t, 2 * _W - 1); \
+	}
+
+	for(uint64_t i = 0; i < BLK; i++) {
+		_dir_fetch(dir0); _dir_fetch(dir1);
+		switch(_dir_is_down(dir0) + 2 * _dir_is_down(dir1)) {
+			case 0: _fill_pack_step(0); break;
+			case 1: _fill_pack_step(1); break;
+			case 2: _fill_pack_step(2); break;
+			default: _fill_pack_step(3); break;
+		}
+	}
+
+	/* store vectors */
+	_fill_pack_store_context(s0, blk0, dir0, aptr0, bptr0, _lo);
+	_fill_pack_store_context(s1, blk1, dir1, aptr1, bptr1, _hi);
+	return;
+}
+
+#ifdef REDEFINE_DEBUG
+#  define DEBUG
+#  undef _LOG_H_INCLUDED
+#  include "log.h"
+#endif
+#endif /* _W == 16 && DIFF == 8 */
+
+/**
+ * @fn fill_mode_seq_bounded
+ * @brief fill blocks in the mode inherited from the root
+ */
+static _force_inline
+struct gaba_block_s *fill_mode_seq_bounded(
+	struct gaba_dp_context_s *self,
+	struct gaba_block_s *blk)
+{
+	switch(self->w.r.fmode) {
+		case GABA_FILL_SCORE_ONLY: return(fill_score_seq_bounded(self, blk));
+		case FILL_GLOBAL: return(fill_global_seq_bounded(self, blk));
+		default: return(_unlikely(self->tb != 0 && fill_end_in_reach(self))
+			? fill_end_seq_bounded(self, blk)
+			: fill_section_seq_bounded(self, blk)
+		);
+	}
+}
+
+/**
+ * @fn fill_load_root_section
+ * @brief create a bridge skipping (apos, bpos) at the head, then load the sections
+ */
+static _force_inline
+void fill_load_root_section(
+	struct gaba_dp_context_s *self,
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	uint32_t pridx)
+{
+	/* load current sections, then transpose sections to extract {id, len, base} pairs */
+	v2i64_t asec = _loadu_v2i64(a), bsec = _loadu_v2i64(b);	/* tuple of (64bit ptr, 32-bit id, 32-bit len) */
+	v2i64_t id_len = _lo_v2i64(asec, bsec), bptr = _hi_v2i64(asec, bsec);
+	v2i32_t id = _cvt_v2i64_v2i32(id_len), len = _cvth_v2i64_v2i32(id_len);
+	v2i32_t adv = _seta_v2i32(bpos, apos);		/* head offsets */
+	_print_v2i32(id); _print_v2i32(len); _print_v2i64(bptr); _print_v2i32(adv);
+
+	/* create bridge (skip (apos, bpos) at the head) */
+	struct gaba_joint_tail_s *brg = fill_create_bridge(self, _root(self), id, len, bptr, adv);
+
+	/* load sections */
+	fill_load_section(self,
+		brg, id, len, bptr,
+		pridx == 0 ? UINT32_MAX : pridx			/* UINT32_MAX */
+	);
+	return;
+}
+
+/**
+ * @fn gaba_dp_fill_root
+ *
+ * @brief build_root API
+ */
+struct gaba_fill_s *_export(gaba_dp_fill_root)(
+	struct gaba_dp_context_s *self,
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	uint32_t pridx)
+{
+	/* restore dp context pointer by adding offset */
+	self = _restore_dp_context(self);
+	_init_bar(head); _init_bar(mid); _init_bar(tail);
+
+	/* create bridge and load sections */
+	fill_load_root_section(self, a, apos, b, bpos, pridx);
+
+	/* load sequences and extract the last block pointer */
+	struct gaba_block_s *blk;
+	if(self->w.r.fmode == GABA_FILL_SCORE_ONLY) {
+		blk = fill_score_load_vectors(self, _root(self));
+	} else {
+		if(_stack_size(&self->stack) < MEM_INIT_VACANCY) {
+			gaba_dp_add_stack(self, _mem_blocks(max_blocks_idx(self)));
+		}
+		blk = fill_load_vectors(self, _root(self));
+	}
+
+	/* init fetch */
+	if(fill_init_fetch(self, blk, _load_v2i64(&_root(self)->f.apos)) < INIT_FETCH_BPOS) {
+		return(_fill(fill_create_tail(self, blk)));
+	}
+
+	/* init fetch done, issue ungapped extension here if filter is needed */
+	/* fill blocks then create a tail cap */
+	return(_fill(fill_create_tail(self, fill_mode_seq_bounded(self, blk))));
+}
+
+/**
+ * @fn gaba_dp_fill
+ *
  * @brief fill API
  */
 struct gaba_fill_s *_export(gaba_dp_fill)(
@@ -2148,10 +3536,15 @@ struct gaba_fill_s *_export(gaba_dp_fill)(
 	/* load sequences and extract the last block pointer */
 	_print_v2i32(_load_v2i32(&_tail(fill)->aridx));
 	_print_v2i32(_load_v2i32(&_tail(fill)->aadv));
-	if(_stack_size(&self->stack) < MEM_INIT_VACANCY) {
-		gaba_dp_add_stack(self, _mem_blocks(max_blocks_idx(self)));
+	struct gaba_block_s *blk;
+	if(self->w.r.fmode == GABA_FILL_SCORE_ONLY) {
+		blk = fill_score_load_vectors(self, _tail(fill));
+	} else {
+		if(_stack_size(&self->stack) < MEM_INIT_VACANCY) {
+			gaba_dp_add_stack(self, _mem_blocks(max_blocks_idx(self)));
+		}
+		blk = fill_load_vectors(self, _tail(fill));
 	}
-	struct gaba_block_s *blk = fill_load_vectors(self, _tail(fill));
 
 	/* check if still in the init (head) state */
 	if((int64_t)_tail(fill)->f.bpos < INIT_FETCH_BPOS) {
@@ -2162,13 +3555,218 @@ struct gaba_fill_s *_export(gaba_dp_fill)(
 	}
 
 	/* fill blocks then create a tail cap */
-	return(_fill(fill_create_tail(self,
-		fill_section_seq_bounded(self, blk)
-	)));
+	return(_fill(fill_create_tail(self, fill_mode_seq_bounded(self, blk))));
+}
+
+
+/* batch fill on the pair kernels; 16-cell bands are packed in a vector, the others are interleaved */
+#if _W == 16 && DIFF == 8
+#  define fill_pair_block		fill_pack_block
+#else
+#  define fill_pair_block		fill_dual_block
+#endif
+
+/**
+ * @fn fill_batch_region_size
+ * @brief #bytes reserved for a seed of the batch fill: the bridge, the phantom, the blocks
+ * (bounded by BATCH_REGION_BLOCKS), and the tail
+ */
+static _force_inline
+uint64_t fill_batch_region_size(
+	struct gaba_seed_s const *seed,
+	uint32_t pridx)
+{
+	uint64_t p = (uint64_t)(seed->a->len - seed->apos) + (uint64_t)(seed->b->len - seed->bpos);
+	uint64_t cnt = MIN2(MIN2(p + p / 2, pridx) / BLK + 1, BATCH_REGION_BLOCKS);
+	return(_roundup(sizeof(struct gaba_joint_tail_s), MEM_ALIGN_SIZE) + _roundup(_mem_blocks(cnt + 1), MEM_ALIGN_SIZE));
+}
+
+/**
+ * @fn fill_batch_test
+ * @brief returns negative if the lane is out of the bulk fill: xdrop detected, ij-bound invaded,
+ * or no space left for the next block and the tail in the region
+ */
+static _force_inline
+int64_t fill_batch_test(
+	struct gaba_dp_context_s const *lane,
+	struct gaba_block_s const *blk)
+{
+	int64_t mem = (int64_t)((uint8_t const *)lane->stack.end - (uint8_t const *)(blk + 2)) - sizeof(struct gaba_joint_tail_s);
+	return(blk->xstat | fill_bulk_test_idx(lane) | mem);
+}
+
+/**
+ * @fn fill_batch_start
+ * @brief carve a region for the seed out of the stack, then load the sections and fetch the
+ * heads in the lane. returns the phantom block, or NULL if the fill completed in the head fetch.
+ */
+static _force_inline
+struct gaba_block_s *fill_batch_start(
+	struct gaba_dp_context_s *self,
+	struct gaba_dp_context_s *lane,
+	struct gaba_seed_s const *seed,
+	uint32_t pridx,
+	struct gaba_fill_s const **fill)
+{
+	uint64_t size = fill_batch_region_size(seed, pridx);
+	if(_stack_size(&self->stack) < size && gaba_dp_add_stack(self, size) != 0) {
+		*fill = NULL;
+		return(NULL);
+	}
+	lane->stack = (struct gaba_stack_s){
+		.mem = self->stack.mem,
+		.top = self->stack.top,
+		.end = self->stack.top + size
+	};
+	self->stack.top += size;
+
+	/* same as gaba_dp_fill_root */
+	fill_load_root_section(lane, seed->a, seed->apos, seed->b, seed->bpos, pridx);
+	struct gaba_block_s *blk = fill_load_vectors(lane, _root(lane));
+	if(fill_init_fetch(lane, blk, _load_v2i64(&_root(lane)->f.apos)) < INIT_FETCH_BPOS) {
+		*fill = _fill(fill_create_tail(lane, blk));
+		return(NULL);
+	}
+	return(blk);
+}
+
+/**
+ * @fn fill_batch_extend
+ * @brief carve a next region for the lane that ran out of its region in the bulk fill, and
+ * continue the fill there with a new phantom block. returns NULL if no memory is available.
+ */
+static _force_inline
+struct gaba_block_s *fill_batch_extend(
+	struct gaba_dp_context_s *self,
+	struct gaba_dp_context_s *lane,
+	struct gaba_block_s *blk)
+{
+	uint64_t size = _roundup(_mem_blocks(BATCH_REGION_BLOCKS), MEM_ALIGN_SIZE);
+	if(_stack_size(&self->stack) < size && gaba_dp_add_stack(self, size) != 0) {
+		return(NULL);
+	}
+	lane->stack = (struct gaba_stack_s){
+		.mem = self->stack.mem,
+		.top = self->stack.top,
+		.end = self->stack.top + size
+	};
+	self->stack.top += size;
+	return(fill_create_phantom(lane, blk, _load_v2i8(&blk->acnt)));
+}
+
+/**
+ * @fn fill_batch_finish
+ * @brief fill the rest of the lane with the single-band kernels. the fill continues in the
+ * stack with a new phantom block if the rest does not fit in the region.
+ */
+static _force_inline
+struct gaba_fill_s const *fill_batch_finish(
+	struct gaba_dp_context_s *self,
+	struct gaba_dp_context_s *lane,
+	struct gaba_block_s *blk)
+{
+	uint64_t rem = (uint64_t)((uint8_t const *)lane->stack.end - (uint8_t const *)(blk + 1));
+	if(blk->xstat >= 0 && rem < (max_blocks_idx(lane) + 1) * sizeof(struct gaba_block_s) + sizeof(struct gaba_joint_tail_s)) {
+		lane->stack = self->stack;
+		if(_stack_size(&lane->stack) < MEM_INIT_VACANCY) {
+			gaba_dp_add_stack(lane, _mem_blocks(max_blocks_idx(lane)));
+		}
+		blk = fill_create_phantom(lane, blk, _load_v2i8(&blk->acnt));
+		struct gaba_fill_s const *fill = _fill(fill_create_tail(lane, fill_section_seq_bounded(lane, blk)));
+		self->stack = lane->stack;
+		return(fill);
+	}
+	return(_fill(fill_create_tail(lane, fill_seq_bounded(lane, blk))));
+}
+
+/**
+ * @fn fill_batch_pair
+ * @brief fill the seeds on a pair of lanes. the lanes are filled together with the pair
+ * kernel while both of them are in the bulk fill, and one going out of the bulk fill is
+ * finished alone then reloaded with the next seed.
+ */
+static _force_inline
+void fill_batch_pair(
+	struct gaba_dp_context_s *self,
+	struct gaba_seed_s const *seed,
+	uint64_t cnt,
+	uint32_t pridx,
+	struct gaba_fill_s const **fill)
+{
+	/* lanes hold the working buffers of the extensions; the score constants are copied */
+	struct gaba_dp_context_s lane[2] __attribute__(( aligned(64) ));
+	for(uint64_t k = 0; k < 2; k++) {
+		_memcpy_blk_aa(&lane[k], self, GABA_DP_CONTEXT_LOAD_SIZE);
+		#ifdef DEBUG
+		{ struct gaba_dp_context_s *self = &lane[k]; _init_bar(head); _init_bar(mid); _init_bar(tail); }
+		#endif
+	}
+
+	struct gaba_block_s *blk[2] = { NULL, NULL };
+	uint64_t idx[2] = { 0, 0 }, next = 0;
+	while(1) {
+		/* reload the empty lanes */
+		for(uint64_t k = 0; k < 2; k++) {
+			while(blk[k] == NULL && next < cnt) {
+				idx[k] = next++;
+				blk[k] = fill_batch_start(self, &lane[k], &seed[idx[k]], pridx, &fill[idx[k]]);
+			}
+		}
+		if(blk[0] == NULL || blk[1] == NULL) { break; }
+
+		/* bulk fill in lock-step */
+		while((fill_batch_test(&lane[0], blk[0]) | fill_batch_test(&lane[1], blk[1])) >= 0) {
+			fill_pair_block(&lane[0], &lane[1], ++blk[0], ++blk[1]);
+		}
+
+		/* move the lanes out of the region to the next ones, and finish the others out of the bulk fill */
+		for(uint64_t k = 0; k < 2; k++) {
+			if(fill_batch_test(&lane[k], blk[k]) >= 0) { continue; }
+			struct gaba_block_s *ph = NULL;
+			if((blk[k]->xstat | fill_bulk_test_idx(&lane[k])) >= 0) {
+				ph = fill_batch_extend(self, &lane[k], blk[k]);
+			}
+			if(ph == NULL) {
+				fill[idx[k]] = fill_batch_finish(self, &lane[k], blk[k]);
+			}
+			blk[k] = ph;
+		}
+	}
+
+	/* seeds ran out */
+	for(uint64_t k = 0; k < 2; k++) {
+		if(blk[k] == NULL) { continue; }
+		fill[idx[k]] = fill_batch_finish(self, &lane[k], blk[k]);
+	}
+	return;
 }
 
+/**
+ * @fn gaba_dp_fill_root_batch
+ * @brief gaba_dp_fill_root for an array of seeds, filled two at a time with the pair kernels.
+ * the score-only fill and the steering policies other than GABA_STEER_EDGE are done one by one.
+ */
+void _export(gaba_dp_fill_root_batch)(
+	struct gaba_dp_context_s *self,
+	struct gaba_seed_s const *seed,
+	uint64_t cnt,
+	uint32_t pridx,
+	struct gaba_fill_s const **fill)
+{
+	struct gaba_dp_context_s *ctx = _restore_dp_context(self);
+	if(ctx->fmode == GABA_FILL_FULL && ctx->steer == GABA_STEER_EDGE) {
+		fill_batch_pair(ctx, seed, cnt, pridx == 0 ? UINT32_MAX : pridx, fill);
+		return;
+	}
+
+	for(uint64_t i = 0; i < cnt; i++) {
+		fill[i] = _export(gaba_dp_fill_root)(self, seed[i].a, seed[i].apos, seed[i].b, seed[i].bpos, pridx);
+	}
+	return;
+}
 
-/* merge bands */
+/* merge bands (not supported for bands wider than 64 cells; the breakpoint masks are 64-bit) */
+#if _W <= 64
 /**
  * @macro _wb, _cb, _mb, _pb
  * @brief buffer accessor macros: wb[i] -> _wb(self, i)
@@ -2270,40 +3868,40 @@ void merge_paste_score_vectors(
 	_storeu_w(_cb(self, q), _max_w(_loadu_w(_cb(self, q)), cv));
 
 	/* max */
-	nvec_t xv = _loadu_n(tail->xd.drop);
-	wvec_t mv = _add_w(cv, _cvt_n_w(xv));
+	dvec_t xv = _loadu_d(tail->xd.drop);
+	wvec_t mv = _add_w(cv, _cvt_d_w(xv));
 	_storeu_w(_mb(self, q), _max_w(_loadu_w(_mb(self, q)), mv));
 
 	/* previous */
 	struct gaba_block_s const *blk = _last_block(tail);
 	#if MODEL == LINEAR
 		/* dh is not negated for linear: cv - dh; offset is ignored */
-		nvec_t dh = _loadu_n(blk->diff.dh);
-		wvec_t pv = _sub_w(cv, _cvt_n_w(dh));
+		dvec_t dh = _loadu_d(blk->diff.dh);
+		wvec_t pv = _sub_w(cv, _cvt_d_w(dh));
 		_storeu_w(_pb(self, q), _max_w(
 			_loadu_w(_pb(self, q)),
 			pv
 		));
 	#else	/* AFFINE and COMBINED */
 		/* negated for affine: cv + -dh */
-		nvec_t dh = _loadu_n(blk->diff.dh);
-		wvec_t pv = _add_w(cv, _cvt_n_w(dh));
+		dvec_t dh = _loadu_d(blk->diff.dh);
+		wvec_t pv = _add_w(cv, _cvt_d_w(dh));
 		_storeu_w(_pb(self, q), _max_w(
 			_loadu_w(_pb(self, q)),
 			pv
 		));
 
 		/* \delta E */
-		nvec_t de = _loadu_n(blk->diff.de);
-		wvec_t ev = _sub_w(cv, _cvt_n_w(de));
+		dvec_t de = _loadu_d(blk->diff.de);
+		wvec_t ev = _sub_w(cv, _cvt_d_w(de));
 		_storeu_w(_eb(self, q), _max_w(
 			_loadu_w(_eb(self, q)),
 			ev
 		));
 
 		/* \delta F */
-		nvec_t df = _loadu_n(blk->diff.df);
-		wvec_t fv = _sub_w(cv, _cvt_n_w(df));
+		dvec_t df = _loadu_d(blk->diff.df);
+		wvec_t fv = _sub_w(cv, _cvt_d_w(df));
 		_storeu_w(_fb(self, q), _max_w(
 			_loadu_w(_fb(self, q)),
 			fv
@@ -2410,30 +4008,30 @@ int32_t merge_slice_vectors(
 	int32_t mdrop = _hmax_w(mv);					/* extract max */
 
 	wvec_t cv = _loadu_w(_cb(self, q));
-	_storeu_n(mt->xd.drop, _cvt_w_n(_sub_w(mv, cv)));
+	_storeu_d(mt->xd.drop, _cvt_w_d(_sub_w(mv, cv)));
 	_storeu_w(mt->md.delta, cv);
 
 	/* calc diff vectors */
 	#if MODEL == LINEAR
 		/* dh is not negated for linear-gap impl */
 		wvec_t dh = _sub_w(cv, _loadu_w(_pb(self, q)));
-		_storeu_n(mg->diff.dh, _cvt_w_n(dh));
+		_storeu_d(mg->diff.dh, _cvt_w_d(dh));
 
 		wvec_t dv = _sub_w(cv, _loadu_w(_pb(self, q - 1)));	/* q - 1 to make the cells in each lane vertically aligned */
-		_storeu_n(mg->diff.dv, _cvt_w_n(dv));
+		_storeu_d(mg->diff.dv, _cvt_w_d(dv));
 	#elif MODEL == AFFINE
 		/* dh is negated for affine */
 		wvec_t dh = _sub_w(_loadu_w(_pb(self, q)), cv);
-		_storeu_n(mg->diff.dh, _cvt_w_n(dh));
+		_storeu_d(mg->diff.dh, _cvt_w_d(dh));
 
 		wvec_t dv = _sub_w(cv, _loadu_w(_pb(self, q - 1)));	/* q - 1 to make the cells in each lane vertically aligned */
-		_storeu_n(mg->diff.dv, _cvt_w_n(dv));
+		_storeu_d(mg->diff.dv, _cvt_w_d(dv));
 
 		wvec_t de = _sub_w(cv, _loadu_w(_eb(self, q)));
-		_storeu_n(mg->diff.de, _cvt_w_n(de));
+		_storeu_d(mg->diff.de, _cvt_w_d(de));
 
 		wvec_t df = _sub_w(cv, _loadu_w(_fb(self, q)));
-		_storeu_n(mg->diff.df, _cvt_w_n(df));
+		_storeu_d(mg->diff.df, _cvt_w_d(df));
 	#endif
 	return(mdrop);
 }
@@ -2501,11 +4099,13 @@ struct gaba_joint_tail_s *merge_create_tail(
 	/* copy tail pointer array */
 	uint32_t pridx = UINT32_MAX;
 	int64_t max = -1;
+	uint32_t zdiag = 0;
 	// int64_t ppos = -1;
 	for(uint64_t i = 0; i < cnt; i++) {
 		struct gaba_joint_tail_s *const tail = _tail(fill[i]);
 		mg->blk[-i] = _last_block(tail);
 		pridx = MIN2(pridx, tail->pridx);
+		if(tail->f.max > max) { zdiag = tail->zdiag; }	/* Z-drop continues from the max of the merged tails */
 		max = MAX2(max, tail->f.max);
 		// ppos = MAX2(ppos, tail->f.ppos);
 	}
@@ -2514,6 +4114,14 @@ struct gaba_joint_tail_s *merge_create_tail(
 	mt->tail = NULL;					/* always NULL */
 	mt->pridx = pridx;
 	mt->f.max = max;
+	mt->f.bw = _W;
+	mt->mblk = NULL;					/* merged tails are always in the full mode */
+	mt->fmode = GABA_FILL_FULL;
+	mt->zdiag = zdiag;
+	mt->eapos = mt->ebpos = EPOS_NONE;	/* tails with the end bonus are not merged */
+	mt->emax = INT64_MIN;
+	mt->eblk = NULL;
+	mt->estat = 0;
 	// mt->f.ppos = ppos;
 
 	/* determine center cell */
@@ -2537,6 +4145,7 @@ struct gaba_joint_tail_s *merge_create_tail(
 	merge_restore_section(self, mt, _tail(fill[self->w.m.uidx]), self->w.m.qw - q, 1);
 	return(mt);
 }
+#endif
 
 /**
  * @fn gaba_dp_merge
@@ -2549,9 +4158,17 @@ struct gaba_fill_s *_export(gaba_dp_merge)(
 	uint8_t const *qofs,
 	uint32_t cnt)
 {
+#if _W > 64
+	return(NULL);						/* unsupported */
+#else
 	self = _restore_dp_context(self);
 	_init_bar(head); _init_bar(mid); _init_bar(tail);
 
+	/* tails filled in the score-only mode do not have masks to be traced, and ones with the end bonus reached the ends */
+	for(uint64_t i = 0; i < cnt; i++) {
+		if(_tail(fill[i])->fmode != GABA_FILL_FULL || _tail(fill[i])->estat != 0) { return(NULL); }
+	}
+
 	/* clear working buffer */
 	if(merge_calc_qspan(self, qofs, cnt) != 0) {
 		return(NULL);					/* fill contains unmergable tail object */
@@ -2563,15 +4180,18 @@ struct gaba_fill_s *_export(gaba_dp_merge)(
 
 	/* slice vectors and copy them to a new tail */
 	return(_fill(merge_create_tail(self, fill, cnt)));
+#endif
 }
 
 
 /* max score search functions */
+#define LEAF_CONV					( UINT64_MAX )		/* the max is before the head of a converted band, held in w.l.blk */
+
 /**
  * @fn leaf_load_max_mask
  */
 static _force_inline
-uint64_t leaf_load_max_mask(
+lmask_t leaf_load_max_mask(
 	struct gaba_dp_context_s *self,
 	struct gaba_joint_tail_s const *tail)
 {
@@ -2581,15 +4201,15 @@ uint64_t leaf_load_max_mask(
 		tail->f.max - tail->mdrop);
 
 	/* load max vector, create mask */
-	nvec_t drop = _loadu_n(tail->xd.drop);
+	dvec_t drop = _loadu_d(tail->xd.drop);
 	wvec_t md = _loadu_w(tail->md.delta);
-	uint64_t max_mask = _mask_u64(_mask_w(_eq_w(
+	lmask_t max_mask = _lmask(_mask_w(_eq_w(
 		_set_w(tail->mdrop),
-		_add_w(md, _cvt_n_w(drop))
+		_add_w(md, _cvt_d_w(drop))
 	)));
-	debug("max_mask(%lx)", max_mask);
+	debug("max_mask(%lx)", _lmask_lo64(max_mask));
 	_print_w(_set_w(tail->mdrop));
-	_print_w(_add_w(md, _cvt_n_w(drop)));
+	_print_w(_add_w(md, _cvt_d_w(drop)));
 	return(max_mask);
 }
 
@@ -2601,16 +4221,16 @@ void leaf_search_pos(
 	struct gaba_dp_context_s *self,
 	nvec_masku_t const *mask_arr,
 	nvec_masku_t const *m,
-	uint64_t max_mask)
+	lmask_t max_mask)
 {
 	/* search max cell, probe from the tail to the head */
-	while(m > mask_arr && (max_mask & ~(--m)->all) != 0) {
-		debug("max_mask(%lx), m(%lx)", max_mask, (uint64_t)m->all);
-		max_mask &= ~m->all;
+	while(m > mask_arr && !_lmask_is_zero(_lmask_andn(_lmask_load(*--m), max_mask))) {
+		debug("max_mask(%lx), m(%lx)", _lmask_lo64(max_mask), _lmask_lo64(_lmask_load(*m)));
+		max_mask = _lmask_andn(_lmask_load(*m), max_mask);
 	}
-	debug("max_mask(%lx), m(%lx)", max_mask, (uint64_t)m->all);
+	debug("max_mask(%lx), m(%lx)", _lmask_lo64(max_mask), _lmask_lo64(_lmask_load(*m)));
 	self->w.l.p = m - mask_arr;
-	self->w.l.q = tzcnt(m->all & max_mask);
+	self->w.l.q = _lmask_tzcnt(_lmask_and(_lmask_load(*m), max_mask));
 	debug("p(%u), q(%u)", self->w.l.p, self->w.l.q);
 }
 
@@ -2628,7 +4248,7 @@ static _force_inline
 void leaf_detect_pos(
 	struct gaba_dp_context_s *self,
 	struct gaba_block_s const *blk,
-	uint64_t max_mask)
+	lmask_t max_mask)
 {
 	#define _fill_block_leaf(_m) { \
 		_dir_fetch(dir); \
@@ -2639,16 +4259,16 @@ void leaf_detect_pos(
 			_fill_down_update_ptr(); \
 			_fill_down(); \
 		} \
-		_m++->mask = _mask_n(_gt_n(delta, max)); \
-		max = _max_n(delta, max); \
-		debug("mask(%lx)", (uint64_t)_mask_u64((_m - 1)->mask)); \
+		_m++->mask = _mask_gt_d(delta, max); \
+		max = _max_d(delta, max); \
+		debug("mask(%lx)", _lmask_lo64(_lmask_load(*(_m - 1)))); \
 	}
 
 	/* load contexts and overwrite max vector */
 	nvec_masku_t mask_arr[BLK], *m = mask_arr;		/* cell-wise update-mask array */
 	/* vectors on registers */ {
-		_fill_load_context(blk);
-		nvec_t max = delta;
+		_fill_load_context(blk, 0);		/* masks are not written back to the block */
+		dvec_t max = delta;
 		for(int64_t i = 0; i < blk->acnt + blk->bcnt; i++) {
 			_fill_block_leaf(m);
 		}
@@ -2666,20 +4286,20 @@ void leaf_detect_pos(
 #endif
 
 /**
- * @fn leaf_search
- * @brief returns resulting path length
+ * @fn leaf_search_block
+ * @brief walk back the blocks to find the block containing the max, returns NULL if the max is at the root
  */
 static _force_inline
-uint64_t leaf_search(
+struct gaba_block_s const *leaf_search_block(
 	struct gaba_dp_context_s *self,
-	struct gaba_joint_tail_s const *tail)
+	struct gaba_joint_tail_s const *tail,
+	lmask_t *pmax_mask,
+	v2i32_t *pridx)
 {
 	/* load mask and block pointers */
-	uint64_t max_mask = leaf_load_max_mask(self, tail);
+	lmask_t max_mask = leaf_load_max_mask(self, tail);
 	struct gaba_block_s const *b = _last_block(tail) + 1;
-	debug("max_mask(%lx)", max_mask);
-
-	_test_bar(head); _test_bar(mid); _test_bar(tail);
+	debug("max_mask(%lx)", _lmask_lo64(max_mask));
 
 	/*
 	 * iteratively clear lanes with longer paths;
@@ -2689,26 +4309,62 @@ uint64_t leaf_search(
 	_print_v2i32(ridx);
 	// if((b[-1].xstat & ROOT_HEAD) == ROOT_HEAD) { debug("reached root, xstat(%x)", b[-1].xstat); return(0); }	/* actually unnecessary but placed as a sentinel */
 	while(1) {
-		if(((--b)->xstat & ROOT) == ROOT) { debug("reached root, xstat(%x)", b->xstat); return(0); }	/* actually unnecessary but placed as a sentinel */
-		while(_unlikely(b->xstat & HEAD)) { b = _phantom(b)->blk; }	/* sometimes head chains more than one */
+		if(((--b)->xstat & ROOT) == ROOT) { debug("reached root, xstat(%x)", b->xstat); return(NULL); }	/* actually unnecessary but placed as a sentinel */
+		while(_unlikely((b->xstat & (HEAD | CONV)) == HEAD)) { b = _phantom(b)->blk; }	/* sometimes head chains more than one */
+		if(_unlikely(b->xstat & CONV)) { debug("reached converted head"); break; }		/* the max is in the previous band */
 
 		/* first adjust ridx to the head of this block then test mask was updated in this block */
 		v2i8_t cnt = _load_v2i8(&b->acnt);
 		ridx = _add_v2i32(ridx, _cvt_v2i8_v2i32(cnt));
 		_print_v2i32(_cvt_v2i8_v2i32(cnt)); _print_v2i32(ridx);
-		debug("max_mask(%lx), update_mask(%lx)", max_mask, (uint64_t)b->max_mask);
-		if((max_mask & ~b->max_mask) == 0) { break; }
-		max_mask &= ~b->max_mask;
+		debug("max_mask(%lx), update_mask(%lx)", _lmask_lo64(max_mask), _lmask_lo64(b->max_mask));
+		if(_lmask_is_zero(_lmask_andn(b->max_mask, max_mask))) { break; }
+		max_mask = _lmask_andn(b->max_mask, max_mask);
 	}
+	*pmax_mask = max_mask;
+	*pridx = ridx;
+	return(b);
+}
 
-	/* calc (p, q) coordinates from block */
-	fill_restore_fetch(self, tail, b, ridx);		/* fetch from existing blocks for p-coordinate search */
-	leaf_detect_pos(self, b, max_mask);				/* calc local p,q-coordinates */
-	self->w.l.blk = b;								/* max detection finished and reader_work has released, save block pointer to writer_work */
+/**
+ * @fn leaf_search_score_block
+ * @brief load the max block recorded in the score-only fill, returns NULL if the max is at the root
+ */
+static _force_inline
+struct gaba_block_s const *leaf_search_score_block(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail,
+	lmask_t *pmax_mask,
+	v2i32_t *pridx)
+{
+	struct gaba_block_s const *b = tail->mblk;
+	if(b == NULL) { debug("max not updated in the section"); return(NULL); }
+
+	/* ridx at the tail of the block is calculated from the positions, then adjusted to the head */
+	v2i32_t dpos = _cvt_v2i64_v2i32(_sub_v2i64(_load_v2i64(&tail->f.apos), _load_v2i64(&tail->mapos)));
+	v2i32_t ridx = _add_v2i32(_load_v2i32(&tail->aridx), dpos);
+	ridx = _add_v2i32(ridx, _cvt_v2i8_v2i32(_load_v2i8(&b->acnt)));
+	_print_v2i32(dpos); _print_v2i32(ridx);
+
+	*pmax_mask = b->max_mask;
+	*pridx = ridx;
+	return(b);
+}
 
+/**
+ * @fn leaf_calc_plen
+ * @brief convert the (p, q) coordinates in the block (self->w.l.blk) to the grid indices, returns resulting path length.
+ * ridx is the reverse indices at the head of the block.
+ */
+static _force_inline
+uint64_t leaf_calc_plen(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail,
+	v2i32_t ridx)
+{
 	/* restore reverse indices */
 	int64_t fcnt = self->w.l.p + 1;					/* #filled vectors */
-	uint32_t dir_mask = _dir_load(self->w.l.blk, fcnt).mask;/* 1 for b-side extension, 0 for a-side extension */
+	dir_mask_t dir_mask = _dir_load(self->w.l.blk, fcnt).mask;/* 1 for b-side extension, 0 for a-side extension */
 	_print_v2i32(ridx);
 	ridx = _sub_v2i32(ridx,
 		_seta_v2i32(
@@ -2735,6 +4391,92 @@ uint64_t leaf_search(
 	return(plen);
 }
 
+/**
+ * @fn leaf_search_end
+ * @brief locate the end cell that took the end bonus (the max was moved to the cell in fill_save_section); returns resulting path length
+ */
+static _force_inline
+uint64_t leaf_search_end(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail)
+{
+	/* walk back to the block, accumulating the reverse indices as in leaf_search_block */
+	v2i32_t ridx = _load_v2i32(&tail->aridx);
+	struct gaba_block_s const *b = _last_block(tail) + 1;
+	do {
+		b--;
+		while((b->xstat & (ROOT | CONV)) == HEAD) { b = _phantom(b)->blk; }
+		if(_unlikely(b->xstat & CONV)) { self->w.l.blk = b; return(LEAF_CONV); }	/* the end cell is in the previous band */
+		ridx = _add_v2i32(ridx, _cvt_v2i8_v2i32(_load_v2i8(&b->acnt)));
+	} while(b != tail->eblk);
+
+	self->w.l.blk = b;
+	self->w.l.p = (tail->estat & ~ESTAT_MAX)>>8;
+	self->w.l.q = tail->estat & 0xff;
+	debug("p(%u), q(%u)", self->w.l.p, self->w.l.q);
+	return(leaf_calc_plen(self, tail, ridx));
+}
+
+/**
+ * @fn leaf_search
+ * @brief returns resulting path length
+ */
+static _force_inline
+uint64_t leaf_search(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail)
+{
+	_test_bar(head); _test_bar(mid); _test_bar(tail);
+
+	/* the max is on the end cell that took the end bonus */
+	if(_unlikely(tail->estat & ESTAT_MAX)) { return(leaf_search_end(self, tail)); }
+
+	/* search the block containing the max */
+	lmask_t max_mask;
+	v2i32_t ridx;
+	struct gaba_block_s const *b = (tail->fmode == GABA_FILL_SCORE_ONLY
+		? leaf_search_score_block(self, tail, &max_mask, &ridx)
+		: leaf_search_block(self, tail, &max_mask, &ridx)
+	);
+	if(b == NULL) { return(0); }
+	if(_unlikely(b->xstat & CONV)) { self->w.l.blk = b; return(LEAF_CONV); }
+
+	/* calc (p, q) coordinates from block */
+	fill_restore_fetch(self, tail, b, ridx);		/* fetch from existing blocks for p-coordinate search */
+	leaf_detect_pos(self, b, max_mask);				/* calc local p,q-coordinates */
+	self->w.l.blk = b;								/* max detection finished and reader_work has released, save block pointer to writer_work */
+	return(leaf_calc_plen(self, tail, ridx));
+}
+
+/**
+ * @fn leaf_search_corner
+ * @brief locate the end cell of the global fill, which is on the last vector of the tail; returns resulting path length
+ */
+static _force_inline
+uint64_t leaf_search_corner(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail)
+{
+	_test_bar(head); _test_bar(mid); _test_bar(tail);
+
+	/* walk back to the last block with vectors, skipping empty blocks and heads */
+	v2i32_t ridx = _load_v2i32(&tail->aridx);
+	struct gaba_block_s const *b = _last_block(tail) + 1;
+	do {
+		b--;
+		while((b->xstat & ROOT) == HEAD) { b = _phantom(b)->blk; }
+		if((b->xstat & ROOT) == ROOT) { debug("reached root, xstat(%x)", b->xstat); return(0); }	/* the end cell is at the root */
+		ridx = _add_v2i32(ridx, _cvt_v2i8_v2i32(_load_v2i8(&b->acnt)));
+	} while(b->acnt + b->bcnt == 0);
+
+	/* the end cell is on the center lane, or the next one if the band stopped one column before the end of a */
+	self->w.l.blk = b;
+	self->w.l.p = b->acnt + b->bcnt - 1;
+	self->w.l.q = _W/2 - (self->gapos - (int64_t)tail->f.apos);
+	debug("p(%u), q(%u)", self->w.l.p, self->w.l.q);
+	return(leaf_calc_plen(self, tail, ridx));
+}
+
 /**
  * @fn gaba_dp_search_max
  */
@@ -2746,8 +4488,14 @@ struct gaba_pos_pair_s *_export(gaba_dp_search_max)(
 	_init_bar(head); _init_bar(mid); _init_bar(tail);
 	struct gaba_joint_tail_s const *tail = _tail(fill);
 
+	uint64_t const plen = leaf_search(self, tail);	/* may return zero */
+	if(_unlikely(plen == LEAF_CONV)) {
+		/* the max is in the band before the conversion; search in the kernel of the band */
+		struct gaba_conv_s const *c = _conv(self->w.l.blk);
+		return(c->search(_export_dp_context_bw(self, c->bw), _fill(_conv_prev(self->w.l.blk))));
+	}
 	struct gaba_pos_pair_s *pos = gaba_dp_malloc(self, sizeof(struct gaba_pos_pair_s));
-	pos->plen = leaf_search(self, tail);		/* may return zero */
+	pos->plen = plen;
 
 	v2i32_t const v11 = _seta_v2i32(1, 1);
 	v2i32_t gidx = _load_v2i32(&self->w.l.agidx), acc = _zero_v2i32();
@@ -2806,7 +4554,7 @@ void trace_reload_section(
 			gidx += tail->istat ? 0 : _r(tail->aadv, i);
 			debug("add istat(%u), ridx(%d), adv(%d), gidx(%d), stat(%x)", tail->istat, _r(tail->aridx, i), _r(tail->aadv, i), gidx, tail->f.status);
 			prev_tail = tail; tail = tail->tail;
-		} while(_r(tail->aridx, i) != 0);
+		} while(_r(tail->aridx, i) != 0 || (int32_t)_r(prev_tail->aadv, i) < 0);	/* a converted front may retreat into the finished section */
 	}
 
 	/* reload finished, store section info */
@@ -2865,12 +4613,18 @@ void trace_push_segment(
 #define TS_H							( 0x01 )
 #define TS_V							( 0x02 )
 #define TS_S							( 0x04 )
+#define TS_D							( 0x08 )		/* inside the diagonal loop (resumed after crossing a converted head) */
+#define TS_X							( 0x10 )		/* crossing a converted head, the trace is continued in the previous band */
 enum {
 	ts_d  = TS_H | TS_V,
 	ts_v0 = TS_V,
 	ts_v1 = TS_V | TS_S,
 	ts_h0 = TS_H,
-	ts_h1 = TS_H | TS_S
+	ts_h1 = TS_H | TS_S,
+	ts_dm = TS_D | TS_V,						/* between the h and v pops of a diagonal */
+	ts_dt = TS_D,								/* after the v pop of a diagonal (or a v pop of a short gap) */
+	ts_hr = ts_d,								/* after an h pop of a short gap */
+	ts_vr = ts_dt
 };
 
 /**
@@ -2915,26 +4669,26 @@ enum {
  * @brief test mask
  */
 #if MODEL == LINEAR
-#define _trace_test_diag_h()			( ((mask->h.all>>q) & 0x01) == 0 )
-#define _trace_test_diag_v()			( ((mask->v.all>>q) & 0x01) == 0 )
-#define _trace_test_gap_h()				( ((mask->h.all>>q) & 0x01) != 0 )
-#define _trace_test_gap_v()				( ((mask->v.all>>q) & 0x01) != 0 )
+#define _trace_test_diag_h()			( _lmask_bit(mask->h, q) == 0 )
+#define _trace_test_diag_v()			( _lmask_bit(mask->v, q) == 0 )
+#define _trace_test_gap_h()				( _lmask_bit(mask->h, q) != 0 )
+#define _trace_test_gap_v()				( _lmask_bit(mask->v, q) != 0 )
 #define _trace_test_fgap_h()			( 0 )
 #define _trace_test_fgap_v()			( 0 )
 #elif MODEL == AFFINE
-#define _trace_test_diag_h()			( ((mask->h.all>>q) & 0x01) == 0 )
-#define _trace_test_diag_v()			( ((mask->v.all>>q) & 0x01) == 0 )
-#define _trace_test_gap_h()				( ((mask->e.all>>q) & 0x01) == 0 )
-#define _trace_test_gap_v()				( ((mask->f.all>>q) & 0x01) == 0 )
+#define _trace_test_diag_h()			( _lmask_bit(mask->h, q) == 0 )
+#define _trace_test_diag_v()			( _lmask_bit(mask->v, q) == 0 )
+#define _trace_test_gap_h()				( _lmask_bit(mask->e, q) == 0 )
+#define _trace_test_gap_v()				( _lmask_bit(mask->f, q) == 0 )
 #define _trace_test_fgap_h()			( 0 )
 #define _trace_test_fgap_v()			( 0 )
 #else /* MODEL == COMBINED */
-#define _trace_test_diag_h()			( ((mask->h.all>>q) & 0x01) == 0 )
-#define _trace_test_diag_v()			( ((mask->v.all>>q) & 0x01) == 0 )
-#define _trace_test_gap_h()				( (((~mask->h.all & mask->e.all)>>q) & 0x01) == 0 )
-#define _trace_test_gap_v()				( (((~mask->v.all & mask->f.all)>>q) & 0x01) == 0 )
-#define _trace_test_fgap_h()			( ((mask->e.all>>q) & 0x01) == 0 )
-#define _trace_test_fgap_v()			( ((mask->f.all>>q) & 0x01) == 0 )
+#define _trace_test_diag_h()			( _lmask_bit(mask->h, q) == 0 )
+#define _trace_test_diag_v()			( _lmask_bit(mask->v, q) == 0 )
+#define _trace_test_gap_h()				( (~_lmask_bit(mask->h, q) & _lmask_bit(mask->e, q)) == 0 )
+#define _trace_test_gap_v()				( (~_lmask_bit(mask->v, q) & _lmask_bit(mask->f, q)) == 0 )
+#define _trace_test_fgap_h()			( _lmask_bit(mask->e, q) == 0 )
+#define _trace_test_fgap_v()			( _lmask_bit(mask->f, q) == 0 )
 #endif
 
 /**
@@ -2944,6 +4698,7 @@ enum {
 	path_array = path_array<<1; \
 	mask--; \
 	q += _dir_mask_is_down(dir_mask); \
+	edge |= ((q + 1) & (_W - 1)) <= 1;		/* q == 0 or q == _W - 1 */ \
 	/*fprintf(stderr, "h: q(%u)\n", q);*/ \
 	_dir_mask_windback(dir_mask); \
 }
@@ -2951,6 +4706,7 @@ enum {
 	path_array = (path_array<<1) | 0x01; \
 	mask--; \
 	q += _dir_mask_is_down(dir_mask) - 1; \
+	edge |= ((q + 1) & (_W - 1)) <= 1; \
 	/*fprintf(stderr, "v: q(%u)\n", q);*/ \
 	_dir_mask_windback(dir_mask); \
 }
@@ -2961,24 +4717,29 @@ enum {
  */
 #define _trace_load_block_rem(_cnt) ({ \
 	debug("ofs(%u), cnt(%lu), path(%p), ofs(%u)", \
-		ofs, (uint64_t)_cnt, path - (ofs < (_cnt)), (uint32_t)(ofs - (_cnt)) & (BLK - 1)); \
-	path -= ofs < (_cnt); \
-	ofs = (ofs - (_cnt)) & (BLK - 1); \
+		ofs, (uint64_t)_cnt, path - ((_cnt) + 31 - ofs) / 32, (uint32_t)(ofs - (_cnt)) & (32 - 1)); \
+	path -= ((_cnt) + 31 - ofs) / 32;		/* path is in 32-bit words */ \
+	ofs = (ofs - (_cnt)) & (32 - 1); \
 	_dir_mask_load(blk, (_cnt)); \
 })
 
 /**
  * @macro _trace_reload_tail
- * @brief reload tail, issued at each band-segment boundaries
+ * @brief reload tail, issued at each band-segment boundaries. the trace terminates with (_cont | TS_X)
+ * at a converted head, where the path is continued in the previous band (trace_cross).
  */
-#define _trace_reload_tail(t, _vec_idx) { \
+#define _trace_reload_tail(t, _vec_idx, _cont) { \
 	/* store path (offset will be adjusted afterwards) */ \
-	_storeu_u64(path, path_array<<ofs); \
+	_storeu_path(path, path_array<<ofs); \
 	/* reload block pointer */ \
 	blk--; do { \
 		debug("reload head block, blk(%p), prev_blk(%p), head(%x), cnt(%u, %u)", blk, _phantom(blk)->blk, _phantom(blk)->blk->xstat & HEAD, _phantom(blk)->blk->acnt, _phantom(blk)->blk->bcnt); \
 		blk = _phantom(blk)->blk; \
-	} while((blk->xstat & HEAD) != 0); \
+	} while((blk->xstat & (HEAD | CONV)) == HEAD); \
+	if(_unlikely(blk->xstat & CONV)) { \
+		mask = blk->mask - 1;				/* no vector remains in the band */ \
+		self->w.l.state = (_cont) | TS_X; goto _trace_term; \
+	} \
 	while(blk->xstat & MERGE) { \
 		struct gaba_merge_s const *_mg = _merge(blk); \
 		blk = _mg->blk[_mg->tidx[_vec_idx][q]]; \
@@ -2987,21 +4748,26 @@ enum {
 	/* reload dir and mask pointer, adjust path offset */ \
 	uint64_t _cnt = blk->acnt + blk->bcnt; \
 	mask = &blk->mask[_cnt - 1]; dir_mask = _trace_load_block_rem(_cnt); \
-	debug("reload tail, path_array(%lx), blk(%p), idx(%lu), mask(%x)", path_array, blk, _cnt - 1, dir_mask); \
+	debug("reload tail, path_array(%lx), blk(%p), idx(%lu), mask(%lx)", path_array, blk, _cnt - 1, (uint64_t)dir_mask); \
 }
 
 /**
  * @macro _trace_reload_block
  * @brief reload block for bulk trace
  */
-#define _trace_reload_block() { \
+#define _trace_reload_block(_cont) { \
 	/* store path (bulk, offset does not change here) */ \
-	_storeu_u64(path, path_array<<ofs); path--; \
+	_storeu_path(path, path_array<<ofs); path -= BLK / 32; \
 	/* reload mask and mask pointer; always test the boundary */ \
 	mask = &(--blk)->mask[BLK - 1]; dir_mask = _dir_mask_load(blk, BLK); \
 	if(_unlikely((_phantom(blk)->xstat & HEAD) != 0)) { \
-		do { blk = _phantom(blk)->blk; debug("reload block, cnt(%u, %u)", blk->acnt, blk->bcnt); } while((_phantom(blk)->xstat & HEAD) != 0); \
-		uint64_t _cnt = blk->acnt + blk->bcnt; path++; \
+		do { blk = _phantom(blk)->blk; debug("reload block, cnt(%u, %u)", blk->acnt, blk->bcnt); } while((_phantom(blk)->xstat & (HEAD | CONV)) == HEAD); \
+		if(_unlikely(_phantom(blk)->xstat & CONV)) {	/* converted head (bulk loop only); gidx is adjusted to the cell */ \
+			path += BLK / 32; mask = blk->mask - 1; \
+			gidx = _add_v2i32(gidx, _seta_v2i32(q - save, save - q)); \
+			self->w.l.state = (_cont) | TS_X; goto _trace_term; \
+		} \
+		uint64_t _cnt = blk->acnt + blk->bcnt; path += BLK / 32; \
 		mask = &blk->mask[_cnt - 1]; dir_mask = _trace_load_block_rem(_cnt); \
 	} \
 	debug("reload block, path_array(%lx), blk(%p), head(%x), mask(%x), ofs(%u), cnt(%u, %u)", path_array, blk, blk->xstat & HEAD, dir_mask, ofs, blk->acnt, blk->bcnt); \
@@ -3031,10 +4797,10 @@ enum {
  * @macro _trace_*_load
  * @brief set _state 0 when in diagonal loop, otherwise pass 1
  */
-#define TRACE_HEAD_CNT			( _W / BLK + (_W == 16) )
-#define _trace_bulk_load_n(t, _state, _jump_to) { \
+#define TRACE_HEAD_CNT			( (_W + BLK - 1) / BLK )
+#define _trace_bulk_load_n(t, _state, _cont, _jump_to) { \
 	if(_unlikely(mask < blk->mask)) { \
-		_trace_reload_block(); \
+		_trace_reload_block(_cont); \
 		if(_unlikely(!_trace_test_bulk())) {	/* adjust gidx */ \
 			if(q >= _W) { goto _trace_term; }	/* out-of-bound check */ \
 			gidx = _add_v2i32(gidx, _seta_v2i32(q - save, save - q)); \
@@ -3045,15 +4811,15 @@ enum {
 		} \
 	} \
 }
-#define _trace_tail_load_n(t, _state, _jump_to) { \
+#define _trace_tail_load_n(t, _state, _cont, _jump_to) { \
 	if(_unlikely(mask < blk->mask)) { \
 		debug("test ph(%p), xstat(%x), ppos(%lu), path(%p, %p), ofs(%u)", \
 			_last_phantom(blk), _last_phantom(blk)->xstat, (path - self->w.l.aln->path) * 32 + ofs, path, self->w.l.aln->path, ofs); \
 		if(_last_phantom(blk)->xstat & HEAD) {	/* head (phantom) block is marked 0x4000 */ \
-			_trace_reload_tail(t, _state);		/* fetch the previous tail */ \
+			_trace_reload_tail(t, _state, _cont);	/* fetch the previous tail */ \
 		} else { \
 			/* load dir and update mask pointer */ \
-			_trace_reload_block();				/* not reached the head yet */ \
+			_trace_reload_block(_cont);			/* not reached the head yet */ \
 			if(--save >= TRACE_HEAD_CNT && _trace_test_bulk()) {	/* adjust gidx, NOTE: both must be evalueted every time */ \
 				debug("save q(%d)", q); \
 				save = q; \
@@ -3076,14 +4842,14 @@ static _force_inline
 void trace_core(
 	struct gaba_dp_context_s *self)
 {
-	#define _pop_vector(_c, _l, _state, _jump_to) { \
+	#define _pop_vector(_c, _l, _state, _cont, _jump_to) { \
 		debug("go %s (%s, %s), dir(%x), mask(%lx, %lx), h(%lx, %lx, %lx), v(%lx, %lx, %lx), p(%ld), q(%d), ptr(%p), path_array(%lx)", \
-			#_l, #_c, #_jump_to, dir_mask, (uint64_t)mask->h.all, (uint64_t)mask->v.all, \
+			#_l, #_c, #_jump_to, dir_mask, _lmask_lo64(_lmask_load(mask->h)), _lmask_lo64(_lmask_load(mask->v)), \
 			(uint64_t)_trace_test_diag_h(), (uint64_t)_trace_test_gap_h(), (uint64_t)_trace_test_fgap_h(), (uint64_t)_trace_test_diag_v(), (uint64_t)_trace_test_gap_v(), (uint64_t)_trace_test_fgap_v(), \
 			(int64_t)(mask - blk->mask), (int32_t)q, mask, path_array); \
 		_trace_##_c##_##_l##_update_index(); \
 		_trace_##_l##_update_path_q(); \
-		_trace_##_c##_load_n(t, _state, _jump_to); \
+		_trace_##_c##_load_n(t, _state, _cont, _jump_to); \
 	}
 	#define _trace_gap_loop(t, _c, _n, _l) { \
 		_trace_##_c##_##_l##_head: \
@@ -3092,7 +4858,7 @@ void trace_core(
 					self->w.l.state = ts_##_l##0; goto _trace_term; \
 				} \
 				_trace_inc_gf_##_l(); \
-				_pop_vector(_c, _l, 1, _trace_##_n##_##_l##_retd); \
+				_pop_vector(_c, _l, 1, ts_##_l##r, _trace_##_n##_##_l##_retd); \
 				goto _trace_##_c##_##_l##_retd; \
 			} \
 			_trace_inc_gi_##_l(); \
@@ -3101,7 +4867,7 @@ void trace_core(
 					self->w.l.state = ts_##_l##1; goto _trace_term; \
 				} \
 				_trace_inc_ge_##_l();	/* increment #gap bases on every iter */ \
-				_pop_vector(_c, _l, 1, _trace_##_n##_##_l##_tail); \
+				_pop_vector(_c, _l, 1, ts_##_l##1, _trace_##_n##_##_l##_tail); \
 			_trace_##_c##_##_l##_tail:; \
 			} while(_trace_test_gap_##_l()); \
 			goto _trace_##_c##_##_l##_retd; \
@@ -3113,9 +4879,9 @@ void trace_core(
 			if(_unlikely(_trace_##_c##_d_test_index())) { \
 				self->w.l.state = ts_d; goto _trace_term; \
 			} \
-			_pop_vector(_c, h, 0, _trace_##_n##_d_mid); \
+			_pop_vector(_c, h, 0, ts_dm, _trace_##_n##_d_mid); \
 		_trace_##_c##_d_mid: \
-			_pop_vector(_c, v, 0, _trace_##_n##_d_tail); \
+			_pop_vector(_c, v, 0, ts_dt, _trace_##_n##_d_tail); \
 		_trace_##_c##_v_retd: _trace_##_c##_d_tail: \
 			if(!_trace_test_diag_v()) { goto _trace_##_c##_v_head; } \
 		} \
@@ -3139,13 +4905,13 @@ void trace_core(
 	/* load path array, adjust path offset to align the head of the current block */
 	uint32_t ofs = self->w.l.ofs;	/* global p-coordinate */
 	uint32_t *path = self->w.l.path;
-	uint64_t path_array = _loadu_u64(path)>>ofs;
+	path_array_t path_array = _loadu_path(path)>>ofs;
 
 	/* load pointers and coordinates */
 	struct gaba_block_s const *blk = self->w.l.blk;
 	struct gaba_mask_pair_s const *mask = &blk->mask[self->w.l.p];
-	uint32_t q = self->w.l.q, save = TRACE_HEAD_CNT;
-	uint32_t dir_mask = _trace_load_block_rem(self->w.l.p + 1);
+	uint32_t q = self->w.l.q, save = TRACE_HEAD_CNT, edge = 0;
+	dir_mask_t dir_mask = _trace_load_block_rem(self->w.l.p + 1);
 
 	/* load grid indices; assigned for each of N+1 boundaries of length-N sequence */
 	register v2i32_t gidx = _load_v2i32(&self->w.l.agidx);
@@ -3158,6 +4924,8 @@ void trace_core(
 		case ts_v1: goto _trace_tail_v_tail;
 		case ts_h0: goto _trace_tail_h_head;
 		case ts_h1: goto _trace_tail_h_tail;
+		case ts_dm: goto _trace_tail_d_mid;
+		case ts_dt: goto _trace_tail_d_tail;
 		default: /* trap(); */ return;			/* broken state */
 	}
 
@@ -3175,10 +4943,10 @@ void trace_core(
 _trace_term:;
 	/* reached a boundary of sections, compensate ofs */
 	uint64_t rem = mask - blk->mask + 1;
-	path += (ofs + rem) >= BLK;
-	ofs = (ofs + rem) & (BLK - 1);
-	_storeu_u64(path, path_array<<ofs);
-	debug("rem(%lu), path(%p), arr(%lx), ofs(%u)", rem, path, path_array<<ofs, ofs);
+	path += (ofs + rem) / 32;
+	ofs = (ofs + rem) & (32 - 1);
+	_storeu_path(path, path_array<<ofs);
+	debug("rem(%lu), path(%p), arr(%lx), ofs(%u)", rem, path, (uint64_t)(path_array<<ofs), ofs);
 
 	/* save gap counts */
 	_store_v2i32(&self->w.l.a.aicnt, gi);
@@ -3190,6 +4958,7 @@ _trace_term:;
 	self->w.l.blk = blk;
 	self->w.l.p = mask - blk->mask;	/* local p-coordinate */
 	self->w.l.q = q;				/* q coordinate */
+	self->w.l.edge |= edge;
 	self->w.l.ofs = ofs;			/* global p-coordinate */
 	_store_v2i32(&self->w.l.agidx, gidx);
 	_print_v2i32(gidx);
@@ -3210,14 +4979,15 @@ void trace_init(
 	struct gaba_dp_context_s *self,
 	struct gaba_joint_tail_s const *tail,
 	struct gaba_alloc_s const *alloc,
-	uint64_t plen)
+	uint64_t plen,
+	int64_t score)
 {
 	/* store tail pointers for sequence segment tracking */
 	self->w.l.atail = tail;
 	self->w.l.btail = tail;
 
 	/* malloc container */
-	uint64_t sn = tail->f.ascnt + tail->f.bscnt + 2, pn = (plen + 31) / 32 + 2;
+	uint64_t sn = tail->f.ascnt + tail->f.bscnt + 2, pn = (plen + 31) / 32 + 2 * BLK_MAX / 32;
 	uint64_t size = (
 		  sizeof(struct gaba_alignment_s)				/* base */
 		+ sizeof(uint32_t) * _roundup(pn, 8)			/* path array and its margin */
@@ -3230,7 +5000,7 @@ void trace_init(
 	self->w.l.a.lfree = alloc->lfree;
 
 	/* use gaba_alignment_s buffer instead in the traceback loop */
-	self->w.l.a.score = tail->f.max;					/* just copy */
+	self->w.l.a.score = score;							/* score of the cell where the trace starts */
 	_store_v2i32(&self->w.l.a.aicnt, _zero_v2i32());	/* clear counters */
 	_store_v2i32(&self->w.l.a.aecnt, _zero_v2i32());
 	_store_v2i32(&self->w.l.afcnt, _zero_v2i32());
@@ -3244,47 +5014,71 @@ void trace_init(
 	/* store block and coordinates */
 	self->w.l.ofs = plen & (32 - 1);
 	self->w.l.state = ts_d;								/* clear state, the traceback always starts with a match */
+	self->w.l.edge = 0;
 	self->w.l.path = self->w.l.aln->path + plen / 32;
 	debug("sn(%lu), seg(%p), pn(%lu), path(%p)", sn, self->w.l.a.seg, pn, self->w.l.path);
 
 	/* clear array */
 	self->w.l.path[0] = 0x01<<self->w.l.ofs;
-	self->w.l.path[1] = 0;
-	self->w.l.path[2] = 0;								/* make sure the memory is "initialized" so that not warned by valgrind */
+	for(uint64_t i = 1; i <= 2 * BLK_MAX / 32; i++) {
+		self->w.l.path[i] = 0;							/* make sure the memory is "initialized" so that not warned by valgrind */
+	}
 	return;
 }
 
 /**
- * @fn trace_body
- * @brief plen = 0 generates an alignment object with no section (not NULL object).
- * may fail when path got lost out of the band and returns NULL object
+ * @fn trace_cross
+ * @brief continue the traceback in the previous band at the converted head (w.l.blk)
  */
-static _force_inline
-struct gaba_alignment_s *trace_body(
-	struct gaba_dp_context_s *self,
-	struct gaba_joint_tail_s const *tail,
-	struct gaba_alloc_s const *alloc,
-	uint64_t plen)
+static
+struct gaba_alignment_s *trace_cross(
+	struct gaba_dp_context_s *self)
 {
-	/* create alignment object */
-	trace_init(self, tail, alloc, plen);
+	struct gaba_conv_s const *c = _conv(self->w.l.blk);
+	debug("cross converted head, q(%d), qofs(%d), bw(%u), state(%x)", self->w.l.q, c->qofs, c->bw, self->w.l.state);
+	if(self->w.l.q >= _W) {
+		/* out of band: abort */
+		self->w.l.a.lfree(self->w.l.a.opaque, (void *)((uint8_t *)self->w.l.aln));
+		return(NULL);
+	}
+	return(c->resume(self, _phantom(self->w.l.blk)->blk, self->w.l.q - c->qofs));
+}
 
+/**
+ * @fn trace_loop
+ * @brief traceback from the current block (w.l.blk) to the root, may fail when path got lost out of the band
+ * and returns NULL object
+ */
+static
+struct gaba_alignment_s *trace_loop(
+	struct gaba_dp_context_s *self)
+{
 	/* blockwise traceback loop, until ppos reaches the root */
 	while(self->w.l.path + self->w.l.ofs > self->w.l.aln->path) {	/* !(self->w.l.path == self->w.l.aln->path && self->w.l.ofs == 0) */
 		_test_bar(head); _test_bar(mid); _test_bar(tail);
 
-		/* update section info; check the next direction */
+		/* update section info; check the next direction (skipped on the resumed trace, which continues the previous fragment) */
 		debug("gidx(%d, %d)", self->w.l.bgidx, self->w.l.agidx);
-		if((int32_t)self->w.l.agidx < (int32_t)((self->w.l.state & TS_H) != 0)) {
-			trace_reload_section(self, 0);
-		}
-		if((int32_t)self->w.l.bgidx < (int32_t)((self->w.l.state & TS_V) != 0)) {
-			trace_reload_section(self, 1);
+		if(_likely((self->w.l.state & TS_X) == 0)) {
+			if((int32_t)self->w.l.agidx < (int32_t)((self->w.l.state & TS_H) != 0)) {
+				trace_reload_section(self, 0);
+			}
+			if((int32_t)self->w.l.bgidx < (int32_t)((self->w.l.state & TS_V) != 0)) {
+				trace_reload_section(self, 1);
+			}
 		}
+		self->w.l.state &= ~TS_X;
 
 		/* fragment trace: q must be inside [0, BW) */
 		trace_core(self);
 		debug("p(%d), q(%d)", self->w.l.p, self->w.l.q);
+		if(_unlikely(self->w.l.state & TS_X)) {
+			/* reached a converted head; the rest (and the identity) is traced in the previous band */
+			if(self->w.l.path + self->w.l.ofs == self->w.l.aln->path) {
+				trace_push_segment(self);	/* the head is on the root; the last segment is closed here */
+			}
+			return(trace_cross(self));
+		}
 		if(_unlikely(self->w.l.q >= _W)) {
 			/* out of band: abort */
 			self->w.l.a.lfree(self->w.l.a.opaque, (void *)((uint8_t *)self->w.l.aln));
@@ -3330,6 +5124,46 @@ struct gaba_alignment_s *trace_body(
 	return(self->w.l.aln);
 }
 
+/**
+ * @fn trace_resume
+ * @brief continue the traceback from the lane q of the last vector of blk, called from trace_cross of the converted band
+ */
+static
+struct gaba_alignment_s *trace_resume(
+	struct gaba_dp_context_s *self,
+	void const *_blk,
+	uint32_t q)
+{
+	struct gaba_block_s const *blk = (struct gaba_block_s const *)_blk;
+	if(q >= _W) {
+		/* the path came from the lanes added by the conversion: abort */
+		self->w.l.a.lfree(self->w.l.a.opaque, (void *)((uint8_t *)self->w.l.aln));
+		return(NULL);
+	}
+	self->w.l.blk = blk;
+	self->w.l.p = blk->acnt + blk->bcnt - 1;
+	self->w.l.q = q;
+	return(trace_loop(self));
+}
+
+/**
+ * @fn trace_body
+ * @brief plen = 0 generates an alignment object with no section (not NULL object).
+ * may fail when path got lost out of the band and returns NULL object
+ */
+static _force_inline
+struct gaba_alignment_s *trace_body(
+	struct gaba_dp_context_s *self,
+	struct gaba_joint_tail_s const *tail,
+	struct gaba_alloc_s const *alloc,
+	uint64_t plen,
+	int64_t score)
+{
+	/* create alignment object */
+	trace_init(self, tail, alloc, plen, score);
+	return(trace_loop(self));
+}
+
 /**
  * @fn gaba_dp_trace
  */
@@ -3350,10 +5184,17 @@ struct gaba_alignment_s *_export(gaba_dp_trace)(
 	};
 	alloc = (alloc == NULL) ? &default_alloc : alloc;
 
+	/* masks are not stored in the score-only mode */
+	if(_tail(fill)->fmode != GABA_FILL_FULL) { return(NULL); }
+
 	/* search and trace */
-	return(trace_body(self, _tail(fill), alloc,
-		(int64_t)fill->bpos < INIT_FETCH_BPOS ? 0 : leaf_search(self, _tail(fill))
-	));
+	uint64_t const plen = (int64_t)fill->bpos < INIT_FETCH_BPOS ? 0 : leaf_search(self, _tail(fill));
+	if(_unlikely(plen == LEAF_CONV)) {
+		/* the max is in the band before the conversion; traced in the kernel of the band */
+		struct gaba_conv_s const *c = _conv(self->w.l.blk);
+		return(c->trace(_export_dp_context_bw(self, c->bw), _fill(_conv_prev(self->w.l.blk)), alloc));
+	}
+	return(trace_body(self, _tail(fill), alloc, plen, fill->max));
 }
 
 
@@ -3371,6 +5212,217 @@ void _export(gaba_dp_res_free)(
 }
 
 
+/* band-width conversion */
+/**
+ * @fn gaba_dp_export_band
+ * @brief copy the last vector of the band out to a width-independent object, the first half of gaba_dp_convert.
+ * returns NULL if the band has no vector of its own (root, bridged, merged, or just-converted tails).
+ */
+void *_export(gaba_dp_export_band)(
+	struct gaba_dp_context_s *self,
+	struct gaba_fill_s const *fill)
+{
+	self = _restore_dp_context(self);
+	struct gaba_joint_tail_s const *tail = _tail(fill);
+	if(tail->istat != 0 || (int64_t)fill->bpos < INIT_FETCH_BPOS) { return(NULL); }
+
+	/* search the block of the last vector, skipping the phantoms of the empty fills */
+	struct gaba_block_s const *blk = _last_block(tail);
+	while((blk->xstat & (ROOT | CONV)) == HEAD) { blk = _phantom(blk)->blk; }
+	if((blk->xstat & (MERGE | CONV)) != 0) { return(NULL); }
+
+	struct gaba_band_s *band = (struct gaba_band_s *)gaba_dp_malloc(self, sizeof(struct gaba_band_s));
+	if(band == NULL) { return(NULL); }
+	band->tail = tail;
+	band->blk = blk;
+	band->c = (struct gaba_conv_s){
+		.resume = trace_resume,
+		.trace = _export(gaba_dp_trace),
+		.search = _export(gaba_dp_search_max),
+		.qofs = 0,
+		.bw = _W
+	};
+	band->acc = blk->acc;
+	for(uint64_t q = 0; q < _W; q++) {
+		band->ch[q] = tail->ch.w[q];
+		band->xd[q] = tail->xd.drop[q];
+		band->md[q] = tail->md.delta[q];
+		band->dh[q] = blk->diff.dh[q];
+		band->dv[q] = blk->diff.dv[q];
+	#if MODEL == AFFINE || MODEL == COMBINED
+		band->de[q] = blk->diff.de[q];
+		band->df[q] = blk->diff.df[q];
+	#endif
+	}
+	return(band);
+}
+
+/**
+ * @fn gaba_dp_import_band
+ * @brief build a tail of the band width from the exported band, the second half of gaba_dp_convert.
+ * lanes are added to (or removed from) the both sides of the band by advancing (or retreating) the fronts
+ * on the sections. the added lanes take the gap pattern of the root. returns NULL if the sections are too
+ * short to move the fronts, or the lane of the max would be removed.
+ */
+struct gaba_fill_s *_export(gaba_dp_import_band)(
+	struct gaba_dp_context_s *self,
+	void const *_band,
+	struct gaba_section_s const *a,
+	struct gaba_section_s const *b)
+{
+	#define _r(_x, _idx)		( (&(_x))[(_idx)] )
+	#if MODEL == LINEAR
+	#  define _dh(_x)			( (int32_t)(diff_lane_t)(_x) )
+	#else
+	#  define _dh(_x)			( (int32_t)(diff_lane_t)(0 - (_x)) )		/* dh is negated in the affine and combined kernels */
+	#endif
+	#define _dv(_x)				( (int32_t)(diff_lane_t)(_x) )
+
+	self = _restore_dp_context(self);
+	struct gaba_band_s const *band = (struct gaba_band_s const *)_band;
+	struct gaba_joint_tail_s const *src = band->tail;
+	struct gaba_section_s const *sec[2] = { a, b };
+	int32_t const bw = band->c.bw, d = (int32_t)_W - bw, n = d < 0 ? -d : d;
+
+	/* lane of the max, always kept in the narrowed band */
+	int32_t qmax = 0;
+	for(int32_t q = 1; q < bw; q++) {
+		if(band->md[q] + band->xd[q] > band->md[qmax] + band->xd[qmax]) { qmax = q; }
+	}
+
+	/*
+	 * the fronts advance on the bases ahead of them to add lanes, or retreat on the bases behind them to remove
+	 * lanes. a finished section is followed by the next one passed, or retreated on if it is passed again.
+	 */
+	int32_t len[2], ridx[2], rem[2], lim[2], next[2];
+	for(uint64_t i = 0; i < 2; i++) {
+		len[i] = sec[i]->len;
+		ridx[i] = _r(src->aridx, i);
+		next[i] = ridx[i] == 0 && sec[i]->id != _r(src->f.aid, i);
+		rem[i] = next[i] ? len[i] : ridx[i];
+		lim[i] = d > 0 ? rem[i] : len[i] - rem[i];
+	}
+
+	/* k lanes on the lane-0 side (moving the front on a) and n - k on the other side (on b), evenly if possible */
+	int32_t lo = MAX2(0, n - lim[1]), hi = MIN2(n, lim[0]);
+	if(d < 0) { lo = MAX2(lo, qmax - (int32_t)_W + 1); hi = MIN2(hi, qmax); }
+	if(lo > hi) {
+		debug("sections too short to convert, n(%d), lim(%d, %d), qmax(%d)", n, lim[0], lim[1], qmax);
+		return(NULL);
+	}
+	int32_t const k = MIN2(MAX2(n / 2, lo), hi);
+	int32_t const adv[2] = { d < 0 ? -k : k, d < 0 ? k - n : n - k };
+	debug("convert, bw(%d -> %u), adv(%d, %d), ridx(%d, %d)", bw, _W, adv[0], adv[1], ridx[0], ridx[1]);
+
+	/* char vector; the bases behind the new fronts are fetched from the sections, and the rest are copied from the band */
+	_memset_blk_a(self->w.r.bufa, 0, 2 * (BW_MAX + BLK_MAX));
+	int32_t cl[2] = { 0, 0 };
+	uint8_t const *ptr[2] = { NULL, NULL };
+	for(uint64_t i = 0; i < 2; i++) {
+		if(rem[i] == 0 || (next[i] && adv[i] == 0)) { continue; }	/* no base to fetch */
+		int32_t const pos = len[i] - rem[i] + adv[i];
+		cl[i] = MIN2((int32_t)_W, pos);
+		ptr[i] = sec[i]->base + pos - cl[i];
+	}
+	fill_fetch_seq_a_n(self, _W - cl[0], ptr[0], cl[0]);
+	for(int32_t p = 0; p < (int32_t)_W - cl[0]; p++) {
+		int32_t const q = (int32_t)_W - 1 - p - adv[0];
+		*_rd_bufa(self, p, 1) = (uint32_t)q < (uint32_t)bw ? band->ch[q] & 0x0f : 0;
+	}
+	fill_fetch_seq_b_n(self, _W - cl[1], ptr[1], cl[1]);
+	for(int32_t p = 0; p < (int32_t)_W - cl[1]; p++) {
+		int32_t const q = p - adv[0];
+		*_rd_bufb(self, p, 1) = (uint32_t)q < (uint32_t)bw ? band->ch[q]>>4 : 0;
+	}
+
+	/* conversion header, phantom, and tail in a chunk */
+	struct gaba_conv_s *c = (struct gaba_conv_s *)gaba_dp_malloc(self,
+		sizeof(struct gaba_conv_s) + sizeof(struct gaba_phantom_s) + sizeof(struct gaba_joint_tail_s));
+	if(c == NULL) { return(NULL); }
+	struct gaba_phantom_s *ph = (struct gaba_phantom_s *)(c + 1);
+	struct gaba_joint_tail_s *tail = (struct gaba_joint_tail_s *)(ph + 1);
+	*c = band->c;
+	c->qofs = adv[0];
+
+	_storeu_n(&tail->ch, _or_n(_loadu_n(_rd_bufa(self, 0, _W)), _shl_n(_loadu_n(_rd_bufb(self, 0, _W)), 4)));
+
+	/* vectors; the added lanes take the diffs of the edge lanes of the root, and the middle deltas are extended from the inner lanes */
+	struct gaba_diff_vec_s const *rdiff = &_last_phantom(_root(self))->diff;
+	for(int32_t q = 0; q < (int32_t)_W; q++) {
+		int32_t const p = q - adv[0], t = p < 0 ? 0 : _W - 1;
+		if((uint32_t)p < (uint32_t)bw) {
+			ph->diff.dh[q] = band->dh[p];
+			ph->diff.dv[q] = band->dv[p];
+		#if MODEL == AFFINE || MODEL == COMBINED
+			ph->diff.de[q] = band->de[p];
+			ph->diff.df[q] = band->df[p];
+		#endif
+			tail->xd.drop[q] = band->xd[p];
+			tail->md.delta[q] = band->md[p];
+		} else {
+			ph->diff.dh[q] = rdiff->dh[t];
+			ph->diff.dv[q] = rdiff->dv[t];
+		#if MODEL == AFFINE || MODEL == COMBINED
+			ph->diff.de[q] = rdiff->de[t];
+			ph->diff.df[q] = rdiff->df[t];
+		#endif
+			tail->xd.drop[q] = -128;
+		}
+	}
+	for(int32_t q = adv[0] - 1; q >= 0; q--) {
+		tail->md.delta[q] = tail->md.delta[q + 1] - _dv(ph->diff.dv[q + 1]) + _dh(ph->diff.dh[q]);
+	}
+	for(int32_t q = adv[0] + bw; q < (int32_t)_W; q++) {
+		tail->md.delta[q] = tail->md.delta[q - 1] - _dh(ph->diff.dh[q - 1]) + _dv(ph->diff.dv[q]);
+	}
+	ph->acc = band->acc;
+	ph->xstat = HEAD | CONV;
+	ph->acnt = ph->bcnt = 0;
+	ph->reserved = 0;
+	ph->blk = band->blk;
+
+	/* sections */
+	uint32_t status = src->f.status & (GABA_TERM | GABA_ZDROP);
+	for(uint64_t i = 0; i < 2; i++) {
+		int32_t const enter = next[i] && adv[i] > 0;				/* the front entered the next section */
+		uint64_t const brk = _r(src->abrk, i);
+		_r(tail->aridx, i) = (enter ? len[i] : ridx[i]) - adv[i];
+		_r(tail->aadv, i) = adv[i];
+		_r(tail->abrk, i) = adv[i] >= 64 || adv[i] <= -64 ? 0 : (adv[i] >= 0 ? brk>>adv[i] : brk<<-adv[i]);
+		_r(tail->atptr, i) = enter ? sec[i]->base + len[i] : _r(src->atptr, i);
+		_r(tail->f.aid, i) = enter ? sec[i]->id : _r(src->f.aid, i);
+		_r(tail->f.ascnt, i) = _r(src->f.ascnt, i) + enter - (ridx[i] == 0) + (_r(tail->aridx, i) == 0);
+		_r(tail->f.apos, i) = _r(src->f.apos, i) + adv[i] - d / 2;	/* positions are of the center lane */
+		status |= _r(tail->aridx, i) == 0 ? (i == 0 ? GABA_UPDATE_A : GABA_UPDATE_B) : 0;
+	}
+	status |= (qmax + adv[0] == 0 || qmax + adv[0] == (int32_t)_W - 1) ? GABA_BAND_EDGE : 0;
+
+	/* the others are carried over */
+	tail->mdrop = src->mdrop;
+	tail->istat = 0;
+	tail->pridx = src->pridx;
+	tail->tail = src;
+	tail->mblk = NULL;
+	tail->mapos = tail->f.apos;
+	tail->mbpos = tail->f.bpos;
+	tail->eapos = src->eapos;
+	tail->ebpos = src->ebpos;
+	tail->emax = src->emax;
+	tail->eblk = src->eblk;
+	tail->fmode = src->fmode;
+	tail->estat = src->estat;
+	tail->zdiag = src->zdiag;
+	tail->f.max = src->f.max;
+	tail->f.status = status;
+	tail->f.bw = _W;
+	return(_fill(tail));
+
+	#undef _r
+	#undef _dh
+	#undef _dv
+}
+
+
 /* score accumulation auxiliary macros */
 /**
  * @macro _hadd_v16i8
@@ -3457,7 +5509,11 @@ struct gaba_score_s *_export(gaba_dp_calc_score)(
 	self = _restore_dp_context(self);
 	_init_bar(head); _init_bar(mid); _init_bar(tail);
 
+#if DIFF == 8
 	v16i8_t sb = _sub_v16i8(_to_v16i8_n(_load_sb(self->scv)), _set_v16i8(self->ofs));
+#else
+	v16i8_t sb = _to_v16i8_n(_load_sb(self->scv));		/* the 16-bit lanes keep the matrix without the offset */
+#endif
 	v2i32_t gac = _zero_v2i32(), fac = _zero_v2i32(), gbc = _zero_v2i32(), fbc = _zero_v2i32();
 	uint64_t xc = 0, dc = 0;
 	int64_t score = 0;
@@ -3550,9 +5606,15 @@ int64_t gaba_init_check_score(
 	struct gaba_params_s const *p)
 {
 	if(_max_match(p) <= 0) { return(-1); }
-	if(_max_match(p) > 6) { return(-1); }
 	if(_min_match(p) >= 0) { return(-1); }
+	if(p->xdrop > XDROP_MAX) { return(-1); }
+	if(p->zdrop < 0) { return(-1); }
+	if(p->end_bonus < 0 || p->end_bonus > INT8_MAX) { return(-1); }
+	if(p->steer > GABA_STEER_DAMPED) { return(-1); }
+#if DIFF == 8
+	if(_max_match(p) > 6) { return(-1); }
 	if(_min_match(p) < -7) { return(-1); }
+#endif
 	if(_min_match(p) < -2 * (p->gi + p->ge)) { return(-1); }
 	if(p->gfa != 0 && p->gfb != 0 && _min_match(p) <= -1 * (p->gfa + p->gfb)) { return(-1); }
 	if(p->ge <= 0) { return(-1); }
@@ -3566,7 +5628,7 @@ int64_t gaba_init_check_score(
 		int32_t t3 = _ofs_v(p) + (_max_match(p) + _gap_h(p, i*2 + 1)) - _gap_h(p, (i + 1) * 2);
 		int32_t t4 = _ofs_v(p) + _gap_h(p, i*2 + 1) - _gap_h(p, i*2);
 
-		if(MAX4(t1, t2, t3, t4) > 127) { return(-1); }
+		if(MAX4(t1, t2, t3, t4) > DIFF_MAX) { return(-1); }
 		if(MIN4(t2, t2, t3, t4) < 0) { return(-1); }
 	}
 	return(0);
@@ -3580,7 +5642,6 @@ struct gaba_score_vec_s gaba_init_score_vector(
 	struct gaba_params_s const *p)
 {
 	v16i8_t scv = _loadu_v16i8(p->score_matrix);
-	int8_t ge = -p->ge, gi = -p->gi;			/* convert to negative values */
 	struct gaba_score_vec_s sc __attribute__(( aligned(MEM_ALIGN_SIZE) ));
 
 	/* score matrices */
@@ -3589,10 +5650,30 @@ struct gaba_score_vec_s gaba_init_score_vector(
 		int8_t x = _hmax_v16i8(_sub_v16i8(_zero_v16i8(), scv));
 		scv = _add_v16i8(_bsl_v16i8(_set_v16i8(m + x), 1), _set_v16i8(-x));
 	#endif
-	_store_sb(sc, _add_v16i8(scv, _set_v16i8(-2 * (ge + gi))));
+
+	#if DIFF == 8
+		int8_t ge = -p->ge, gi = -p->gi;			/* convert to negative values */
+		_store_sb(sc, _add_v16i8(scv, _set_v16i8(-2 * (ge + gi))));
+	#else
+		/* the offset does not fit in int8; the matrix is kept as is and the offset is added after widening */
+		int16_t ge = -p->ge, gi = -p->gi;
+		_store_sb(sc, scv);
+	#endif
 
 	/* gap penalties; adj, ofs, gfh, gfv */
-	#if MODEL == LINEAR
+	#if DIFF == 16
+		/* int16 constants in the last row (see _scv_w) */
+		int16_t *w = (int16_t *)sc.v5;
+		#if MODEL == LINEAR
+			w[0] = 0; w[1] = ge + gi; w[2] = 0; w[3] = 0;
+		#elif MODEL == AFFINE
+			w[0] = -gi; w[1] = ge + gi; w[2] = 0; w[3] = 0;
+		#else	/* COMBINED */
+			int16_t gfa = -p->gfa, gfb = -p->gfb;
+			w[0] = -gi; w[1] = ge + gi; w[2] = -(ge + gi) + gfb; w[3] = -(ge + gi) + gfa;
+		#endif
+		w[4] = -2 * (ge + gi);
+	#elif MODEL == LINEAR
 		_store_adjh(sc, 0, ge + gi, 0, 0);
 		_store_adjv(sc, 0, ge + gi, 0, 0);
 		_store_ofsh(sc, 0, ge + gi, 0, 0);
@@ -3661,7 +5742,7 @@ struct gaba_diff_vec_s gaba_init_diff_vectors(
 	}
 	#if MODEL == AFFINE || MODEL == COMBINED
 		/* negate dh for affine and combined */
-		_store_n(&diff.dh, _sub_n(_zero_n(), _load_n(&diff.dh)));
+		_store_d(&diff.dh, _sub_d(_zero_d(), _load_d(&diff.dh)));
 	#endif
 	return(diff);
 }
@@ -3698,6 +5779,7 @@ void gaba_init_phantom(
 		.f = {
 			.max = init_max,
 			.status = CONT | GABA_UPDATE_A | GABA_UPDATE_B,
+			.bw = _W,
 			.ascnt = 0,    .bscnt = 0,
 			.apos = -_W/2, .bpos = -_W/2,
 			.aid = 0,      .bid = 0,
@@ -3705,6 +5787,8 @@ void gaba_init_phantom(
 
 		/* section info */
 		.tail = NULL,
+		.eapos = EPOS_NONE, .ebpos = EPOS_NONE,
+		.emax = INT64_MIN,
 		.aridx = 0,    .bridx = 0,
 		.aadv = 0,     .badv = 0,
 		.atptr = NULL, .btptr = NULL,
@@ -3719,8 +5803,8 @@ void gaba_init_phantom(
 
 	/* add offsets */
 	ph->tail.mdrop -= 128;
-	_store_n(&ph->tail.xd.drop,
-		_add_n(_load_n(&ph->tail.xd.drop), _set_n(-128))
+	_storeu_d(&ph->tail.xd.drop,
+		_add_d(_loadu_d(&ph->tail.xd.drop), _set_d(-128))
 	);
 	return;
 }
@@ -3756,7 +5840,11 @@ void gaba_init_dp_context(
 		/* score vectors */
 		.scv = gaba_init_score_vector(p),
 		.tx = p->xdrop - 128,
+		.txlim = XDROP_MAX,
+		.tz = p->zdrop,
+		.tb = p->end_bonus,
 		.tf = p->filter_thresh,
+		.steer = p->steer,
 
 		.gi = -p->gi, .ge = -p->ge, .gfa = -p->gfa, .gfb = -p->gfb,
 		.imx = 1 / (m - x), .xmx = x / (m - x),
@@ -3767,7 +5855,9 @@ void gaba_init_dp_context(
 		.root = {
 			[_dp_ctx_index(16)] = &_proot(ctx, 16)->tail,
 			[_dp_ctx_index(32)] = &_proot(ctx, 32)->tail,
-			[_dp_ctx_index(64)] = &_proot(ctx, 64)->tail
+			[_dp_ctx_index(64)] = &_proot(ctx, 64)->tail,
+			[_dp_ctx_index(128)] = &_proot(ctx, 128)->tail,
+			[_dp_ctx_index(256)] = &_proot(ctx, 256)->tail
 		}
 	};
 	debug("g(%d, %d, %d, %d), g(%d, %d, %d, %d)",
@@ -3911,6 +6001,52 @@ void _export(gaba_dp_flush)(
 	return;
 }
 
+/**
+ * @fn gaba_dp_set_fill_mode
+ * @brief set fill mode of the succeeding gaba_dp_fill_root calls, returns the previous mode
+ */
+uint32_t _export(gaba_dp_set_fill_mode)(
+	struct gaba_dp_context_s *self,
+	uint32_t mode)
+{
+	self = _restore_dp_context(self);
+
+	uint32_t prev = self->fmode;
+	self->fmode = (mode == GABA_FILL_FULL) ? GABA_FILL_FULL : GABA_FILL_SCORE_ONLY;
+	return(prev);
+}
+
+/**
+ * @fn gaba_dp_set_xdrop
+ * @brief set xdrop threshold of the succeeding fill calls, returns the previous threshold (-1 if out of range)
+ */
+int32_t _export(gaba_dp_set_xdrop)(
+	struct gaba_dp_context_s *self,
+	int32_t xdrop)
+{
+	self = _restore_dp_context(self);
+
+	if(xdrop <= 0 || xdrop > self->txlim) { return(-1); }
+	int32_t prev = self->tx + 128;
+	self->tx = xdrop - 128;
+	return(prev);
+}
+
+/**
+ * @fn gaba_dp_set_anchor
+ * @brief set anchor diagonal (apos - bpos) of the succeeding fill calls (GABA_STEER_ANCHOR), returns the previous one
+ */
+int64_t _export(gaba_dp_set_anchor)(
+	struct gaba_dp_context_s *self,
+	int64_t diag)
+{
+	self = _restore_dp_context(self);
+
+	int64_t prev = self->adiag;
+	self->adiag = diag;
+	return(prev);
+}
+
 /**
  * @fn gaba_dp_save_stack
  */
@@ -3967,38 +6103,342 @@ void *gaba_dp_malloc(
 }
 
 /**
- * @fn gaba_dp_free
- * @brief do nothing
+ * @fn gaba_dp_free
+ * @brief do nothing
+ */
+static _force_inline
+void gaba_dp_free(
+	struct gaba_dp_context_s *self,
+	void *ptr)
+{
+	return;
+}
+
+/**
+ * @fn gaba_dp_clean
+ */
+void _export(gaba_dp_clean)(
+	struct gaba_dp_context_s *self)
+{
+	if(self == NULL) {
+		return;
+	}
+
+	/* restore dp context pointer by adding offset */
+	self = _restore_dp_context(self);
+
+	struct gaba_mem_block_s *m = self->mem.next;
+	debug("cleanup memory chain, m(%p)", m);
+	while(m != NULL) {
+		struct gaba_mem_block_s *mnext = m->next;
+		debug("free m(%p), mnext(%p)", m, mnext);
+		gaba_free(m); m = mnext;
+	}
+	gaba_free(_export_dp_context_global(self));
+	return;
+}
+
+/**
+ * @fn extend_fill_max
+ * @brief extend the root until X-drop termination, substituting the tail section for the ones
+ * reached the end. returns the fill object with the max.
+ */
+static _force_inline
+struct gaba_fill_s const *extend_fill_tail(
+	struct gaba_dp_context_s *self,		/* exported pointer */
+	struct gaba_fill_s const *f,
+	struct gaba_section_s const *a,
+	struct gaba_section_s const *b,
+	struct gaba_section_s const *tail)
+{
+	struct gaba_fill_s const *m = f;
+	while((f->status & GABA_TERM) == 0) {
+		if(f->status & GABA_UPDATE_A) { a = tail; }
+		if(f->status & GABA_UPDATE_B) { b = tail; }
+		if(a == NULL || b == NULL) { break; }	/* no tail given */
+		f = _export(gaba_dp_fill)(self, f, a, b, 0);
+		m = f->max > m->max ? f : m;
+	}
+	return(m);
+}
+static _force_inline
+struct gaba_fill_s const *extend_fill_max(
+	struct gaba_dp_context_s *self,		/* exported pointer */
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	struct gaba_section_s const *tail)
+{
+	return(extend_fill_tail(self, _export(gaba_dp_fill_root)(self, a, apos, b, bpos, 0), a, b, tail));
+}
+
+/**
+ * @fn gaba_dp_extend_screened
+ * @brief two-pass extension: the first pass fills the matrix in the score-only mode, then
+ * the extension is repeated with traceback only when its max reached the threshold.
+ * the stack is rewound after the first pass, so rejected extensions leave no blocks on it.
+ */
+struct gaba_alignment_s *_export(gaba_dp_extend_screened)(
+	struct gaba_dp_context_s *self,
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	struct gaba_section_s const *tail,
+	int64_t threshold,
+	struct gaba_alloc_s const *alloc)
+{
+	/* first pass: score only */
+	uint32_t fmode = _export(gaba_dp_set_fill_mode)(self, GABA_FILL_SCORE_ONLY);
+	struct gaba_stack_s const *stack = _export(gaba_dp_save_stack)(self);
+	int64_t max = extend_fill_max(self, a, apos, b, bpos, tail)->max;
+	_export(gaba_dp_flush_stack)(self, stack);
+
+	debug("max(%ld), threshold(%ld)", max, threshold);
+	if(max < threshold) {
+		_export(gaba_dp_set_fill_mode)(self, fmode);
+		return(NULL);
+	}
+
+	/* second pass: refill with masks, then trace */
+	_export(gaba_dp_set_fill_mode)(self, GABA_FILL_FULL);
+	struct gaba_fill_s const *m = extend_fill_max(self, a, apos, b, bpos, tail);
+	_export(gaba_dp_set_fill_mode)(self, fmode);
+	return(_export(gaba_dp_trace)(self, m, alloc));
+}
+
+/**
+ * @fn gaba_dp_extend_banded
+ * @brief extend and trace, accepting the result only if the band was wide enough: the max is off the
+ * edge lanes (GABA_BAND_EDGE) and the path stays inside the band without visiting lane 0 or _W - 1.
+ * returns NULL otherwise, with the stack rewound (see gaba_dp_extend_adaptive in gaba_wrap.h).
+ */
+struct gaba_alignment_s *_export(gaba_dp_extend_banded)(
+	struct gaba_dp_context_s *self,		/* exported pointer */
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	struct gaba_section_s const *tail,
+	struct gaba_alloc_s const *alloc)
+{
+	struct gaba_stack_s const *stack = _export(gaba_dp_save_stack)(self);
+	struct gaba_fill_s const *m = extend_fill_max(self, a, apos, b, bpos, tail);
+
+	struct gaba_alignment_s *r = NULL;
+	if((m->status & GABA_BAND_EDGE) == 0) {
+		r = _export(gaba_dp_trace)(self, m, alloc);
+	}
+	if(r != NULL && _restore_dp_context(self)->w.l.edge != 0) {
+		_export(gaba_dp_res_free)(self, r);
+		r = NULL;
+	}
+	if(r == NULL) {
+		_export(gaba_dp_flush_stack)(self, stack);
+	}
+	return(r);
+}
+
+/**
+ * @fn gaba_dp_align_global
+ * @brief banded end-to-end alignment of a[apos, aend) and b[bpos, bend). the band is filled without
+ * X-drop termination and steered to (aend, bend), where the traceback starts.
+ */
+struct gaba_alignment_s *_export(gaba_dp_align_global)(
+	struct gaba_dp_context_s *self,		/* exported pointer */
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	uint32_t aend,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	uint32_t bend,
+	struct gaba_alloc_s const *alloc)
+{
+	struct gaba_dp_context_s *ctx = _restore_dp_context(self);
+
+	/* the sections are clipped at the ends, and the edges of the band run into the padding (read BLK bytes past the end) */
+	static uint8_t const pad[_W + BLK] = { 0 };
+	struct gaba_section_s const sec[4] = {
+		{ .id = a->id, .len = aend, .base = a->base },
+		{ .id = b->id, .len = bend, .base = b->base },
+		{ .id = a->id, .len = _W, .base = pad },
+		{ .id = b->id, .len = _W, .base = pad }
+	};
+	struct gaba_section_s const *as = aend > apos ? &sec[0] : &sec[2];
+	struct gaba_section_s const *bs = bend > bpos ? &sec[1] : &sec[3];
+
+	/* fill until the last vector reaches the anti-diagonal of the end cell */
+	uint32_t fmode = ctx->fmode;
+	ctx->fmode = FILL_GLOBAL;
+	ctx->gapos = aend - apos;
+	ctx->gbpos = bend - bpos;
+	struct gaba_fill_s const *f = _export(gaba_dp_fill_root)(self, as, aend > apos ? apos : 0, bs, bend > bpos ? bpos : 0, 0);
+	while((int64_t)(f->apos + f->bpos) + 1 < ctx->gapos + ctx->gbpos) {
+		if(f->status & GABA_UPDATE_A) { as = &sec[2]; }
+		if(f->status & GABA_UPDATE_B) { bs = &sec[3]; }
+		f = _export(gaba_dp_fill)(self, f, as, bs, 0);
+	}
+	ctx->fmode = fmode;
+
+	/* restore default alloc if NULL */
+	struct gaba_alloc_s const default_alloc = {
+		.opaque = (void *)ctx,
+		.lmalloc = (gaba_lmalloc_t)gaba_dp_malloc,
+		.lfree = (gaba_lfree_t)gaba_dp_free
+	};
+	alloc = (alloc == NULL) ? &default_alloc : alloc;
+
+	/* score of the end cell (the current score is md - 128 on each lane), then trace from the cell */
+	struct gaba_joint_tail_s const *tail = _tail(f);
+	uint64_t plen = leaf_search_corner(ctx, tail);
+	int64_t score = plen == 0 ? 0 : _offset(tail) + tail->md.delta[ctx->w.l.q] - 128;
+	return(trace_body(ctx, tail, alloc, plen, score));
+}
+
+/**
+ * @fn gaba_dp_align_local
+ * @brief start-free extension: the end is the max of the extension from (apos, bpos), and the start
+ * is the max of the reverse extension from the end back to (apos, bpos); the path between them is
+ * aligned with gaba_dp_align_global. the two searches are done in the score-only mode.
+ */
+struct gaba_alignment_s *_export(gaba_dp_align_local)(
+	struct gaba_dp_context_s *self,		/* exported pointer */
+	struct gaba_section_s const *a,
+	uint32_t apos,
+	struct gaba_section_s const *b,
+	uint32_t bpos,
+	struct gaba_section_s const *tail,
+	struct gaba_alloc_s const *alloc)
+{
+	uint32_t fmode = _export(gaba_dp_set_fill_mode)(self, GABA_FILL_SCORE_ONLY);
+	struct gaba_stack_s const *stack = _export(gaba_dp_save_stack)(self);
+
+	/* forward: the end of the alignment; the max in the tail is clipped at the end of the section */
+	uint32_t aend = apos, bend = bpos;
+	struct gaba_fill_s const *m = extend_fill_max(self, a, apos, b, bpos, tail);
+	if(m->max > 0) {
+		struct gaba_pos_pair_s const *e = _export(gaba_dp_search_max)(self, m);
+		aend = e->aid == a->id ? e->apos : a->len;
+		bend = e->bid == b->id ? e->bpos : b->len;
+	}
+
+	/* reverse: the start, from the end back to the root; the negative prefix is not included in the max */
+	uint32_t astart = aend, bstart = bend;
+	if(m->max > 0) {
+		struct gaba_section_s const ra = { .id = a->id, .len = aend - apos, .base = gaba_mirror(a->base + apos, aend - apos) };
+		struct gaba_section_s const rb = { .id = b->id, .len = bend - bpos, .base = gaba_mirror(b->base + bpos, bend - bpos) };
+		struct gaba_section_s const rt = { .id = tail->id, .len = tail->len, .base = gaba_mirror(tail->base, tail->len) };
+		struct gaba_fill_s const *r = extend_fill_max(self, &ra, 0, &rb, 0, &rt);
+		struct gaba_pos_pair_s const *s = _export(gaba_dp_search_max)(self, r);
+		astart = aend - (s->aid == a->id ? s->apos : ra.len);
+		bstart = bend - (s->bid == b->id ? s->bpos : rb.len);
+	}
+	_export(gaba_dp_flush_stack)(self, stack);
+	debug("start(%u, %u), end(%u, %u)", astart, bstart, aend, bend);
+
+	/* trace between the two */
+	_export(gaba_dp_set_fill_mode)(self, GABA_FILL_FULL);
+	struct gaba_alignment_s *aln = _export(gaba_dp_align_global)(self, a, astart, aend, b, bstart, bend, alloc);
+	_export(gaba_dp_set_fill_mode)(self, fmode);
+	return(aln);
+}
+
+/**
+ * @struct gaba_batch_key_s
+ * @brief seed index sorted by the address of the reference (a-side) sequence.
+ */
+struct gaba_batch_key_s {
+	uint64_t addr, idx;
+};
+
+/**
+ * @fn fill_batch_addr
+ * @brief address of the head of the seed on memory; mirrored sections are read backward from there.
+ */
+static _force_inline
+uint8_t const *fill_batch_addr(
+	struct gaba_section_s const *s,
+	uint32_t pos)
+{
+	uint8_t const *p = s->base + pos;
+	return(p < GABA_EOU ? p : gaba_mirror(p, 1));
+}
+
+/**
+ * @fn fill_batch_prefetch
+ * @brief touch the heads of the both sequences of the seed.
  */
 static _force_inline
-void gaba_dp_free(
-	struct gaba_dp_context_s *self,
-	void *ptr)
+void fill_batch_prefetch(
+	struct gaba_seed_s const *seed)
 {
+	uint8_t const *a = fill_batch_addr(seed->a, seed->apos), *b = fill_batch_addr(seed->b, seed->bpos);
+	a -= seed->a->base < GABA_EOU ? 0 : BATCH_PREFETCH_SIZE - 1;
+	b -= seed->b->base < GABA_EOU ? 0 : BATCH_PREFETCH_SIZE - 1;
+	for(uint64_t i = 0; i < BATCH_PREFETCH_SIZE; i += 64) {
+		__builtin_prefetch(a + i);
+		__builtin_prefetch(b + i);
+	}
 	return;
 }
 
 /**
- * @fn gaba_dp_clean
+ * @fn fill_batch_comp
+ * @brief comparator for qsort
  */
-void _export(gaba_dp_clean)(
-	struct gaba_dp_context_s *self)
+static
+int fill_batch_comp(
+	void const *x,
+	void const *y)
 {
-	if(self == NULL) {
-		return;
-	}
+	struct gaba_batch_key_s const *p = (struct gaba_batch_key_s const *)x, *q = (struct gaba_batch_key_s const *)y;
+	return((p->addr > q->addr) - (p->addr < q->addr));
+}
 
-	/* restore dp context pointer by adding offset */
-	self = _restore_dp_context(self);
+/**
+ * @fn gaba_dp_fill_batch
+ * @brief extend all the seeds until X-drop termination and store the fill objects with the max.
+ * seeds are processed in the order of the reference address, BATCH_CHUNK_SIZE at once; the roots
+ * of a chunk are filled by gaba_dp_fill_root_batch, then the heads of the next chunk are prefetched
+ * while the current ones are extended.
+ */
+void _export(gaba_dp_fill_batch)(
+	struct gaba_dp_context_s *self,
+	struct gaba_seed_s const *seed,
+	uint64_t cnt,
+	struct gaba_fill_s const **max)
+{
+	if(cnt == 0) { return; }
 
-	struct gaba_mem_block_s *m = self->mem.next;
-	debug("cleanup memory chain, m(%p)", m);
-	while(m != NULL) {
-		struct gaba_mem_block_s *mnext = m->next;
-		debug("free m(%p), mnext(%p)", m, mnext);
-		gaba_free(m); m = mnext;
+	/* sort; the key array is left on the stack and discarded on flush */
+	struct gaba_batch_key_s *key = gaba_dp_malloc(_restore_dp_context(self), sizeof(struct gaba_batch_key_s) * cnt);
+	for(uint64_t i = 0; i < cnt; i++) {
+		key[i] = (struct gaba_batch_key_s){
+			.addr = (uint64_t)fill_batch_addr(seed[i].a, seed[i].apos),
+			.idx = i
+		};
+	}
+	qsort(key, cnt, sizeof(struct gaba_batch_key_s), fill_batch_comp);
+
+	struct gaba_seed_s s[BATCH_CHUNK_SIZE];
+	struct gaba_fill_s const *f[BATCH_CHUNK_SIZE];
+	for(uint64_t i = 0; i < MIN2(cnt, BATCH_CHUNK_SIZE); i++) {
+		fill_batch_prefetch(&seed[key[i].idx]);
+	}
+	for(uint64_t i = 0; i < cnt; i += BATCH_CHUNK_SIZE) {
+		uint64_t const n = MIN2(cnt - i, BATCH_CHUNK_SIZE);
+		for(uint64_t j = 0; j < n; j++) { s[j] = seed[key[i + j].idx]; }
+		_export(gaba_dp_fill_root_batch)(self, s, n, 0, f);
+
+		/* the next chunk is touched while the current one is extended */
+		for(uint64_t j = i + n; j < MIN2(cnt, i + n + BATCH_CHUNK_SIZE); j++) {
+			fill_batch_prefetch(&seed[key[j].idx]);
+		}
+		for(uint64_t j = 0; j < n; j++) {
+			max[key[i + j].idx] = extend_fill_tail(self, f[j], s[j].a, s[j].b, s[j].tail);
+		}
 	}
-	gaba_free(_export_dp_context_global(self));
 	return;
 }
 
@@ -4037,6 +6477,18 @@ static struct gaba_params_s const *unittest_default_params[8] = {
 	GABA_PARAMS(.xdrop = 80, GABA_SCORE_SIMPLE(5, 3, 0, 8)),
 	GABA_PARAMS(.xdrop = 80, GABA_SCORE_SIMPLE(5, 7, 0, 5))
 };
+#elif defined(PRESET)
+/* the kernels ignore the scores in the context; all the tests run with the preset */
+static struct gaba_params_s const *unittest_default_params[8] = {
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET)),
+	GABA_PARAMS(.xdrop = 80, GABA_SCORE_PRESET(PRESET))
+};
 #elif MODEL == AFFINE
 static struct gaba_params_s const *unittest_default_params[8] = {
 	GABA_PARAMS(.xdrop = 80, GABA_SCORE_SIMPLE(2, 3, 5, 1)),
@@ -4683,6 +7135,63 @@ struct unittest_naive_result_s unittest_naive(
 	return(result);
 }
 
+/**
+ * @fn unittest_naive_score
+ * @brief score of the end-to-end alignment (unbanded), same recurrence as unittest_naive.
+ * local == 1 floors the scores at zero and returns the max (Smith-Waterman); local == 2 returns
+ * the best cell on the last row or column (the alignment reaching the end of either sequence).
+ */
+static
+int64_t unittest_naive_score(
+	struct gaba_params_s const *sc,
+	char const *a, char const *b,
+	int local)
+{
+	v16i8_t scv = _loadu_v16i8(sc->score_matrix);
+	int64_t m = _hmax_v16i8(scv);
+	int64_t x = -_hmax_v16i8(_sub_v16i8(_zero_v16i8(), scv));
+	int64_t gi = -sc->gi, ge = -sc->ge;
+	int64_t gfa = sc->gfa == 0 ? gi + 2 * ge : -sc->gfa;
+	int64_t gfb = sc->gfb == 0 ? gi + 2 * ge : -sc->gfb;
+
+	/* s, e, f of the previous and the current columns */
+	uint64_t alen = strlen(a), blen = strlen(b);
+	int64_t *mat = (int64_t *)malloc(6 * (alen + 1) * sizeof(int64_t));
+	int64_t *ps = &mat[0], *pe = &mat[alen + 1], *pf = &mat[2 * (alen + 1)];
+	int64_t *cs = &mat[3 * (alen + 1)], *ce = &mat[4 * (alen + 1)], *cf = &mat[5 * (alen + 1)];
+	int64_t const min = INT32_MIN / 2, floor = local == 1 ? 0 : min;
+	int64_t max = 0, emax = min;
+
+	ps[0] = pe[0] = pf[0] = 0;
+	for(uint64_t i = 1; i < alen + 1; i++) {
+		ps[i] = pe[i] = MAX3(floor, gi + (int64_t)i * ge, (int64_t)i * gfb);
+		pf[i] = min;
+	}
+	for(uint64_t j = 1; j < blen + 1; j++) {
+		cs[0] = cf[0] = MAX3(floor, gi + (int64_t)j * ge, (int64_t)j * gfa);
+		ce[0] = min;
+		for(uint64_t i = 1; i < alen + 1; i++) {
+			ce[i] = MAX2(cs[i - 1] + gi + ge, ce[i - 1] + ge);
+			cf[i] = MAX2(ps[i] + gi + ge, pf[i] + ge);
+			cs[i] = MAX4(floor,
+				ps[i - 1] + (a[i - 1] == b[j - 1] ? m : x),
+				MAX2(ce[i], cs[i - 1] + gfb),
+				MAX2(cf[i], ps[i] + gfa)
+			);
+			max = MAX2(max, cs[i]);
+		}
+		emax = MAX2(emax, cs[alen]);
+		int64_t *t;
+		t = ps; ps = cs; cs = t;
+		t = pe; pe = ce; ce = t;
+		t = pf; pf = cf; cf = t;
+	}
+	for(uint64_t i = 0; i < alen + 1; i++) { emax = MAX2(emax, ps[i]); }
+	int64_t score = local == 2 ? emax : (local ? max : ps[alen]);
+	free(mat);
+	return(score);
+}
+
 #if MODEL == LINEAR
 unittest( .name = "naive" )
 {
@@ -4713,6 +7222,8 @@ unittest( .name = "naive" )
 	assert(check_naive_result(n, 8, "DRDRDDDRDRDRDRDRDRDRDR"), print_naive_result(n));
 	free(n.path); free(n.sec);
 }
+#elif defined(PRESET)
+/* the naive implementation is tested in the generic affine kernels */
 #elif MODEL == AFFINE
 unittest( .name = "naive" )
 {
@@ -5225,6 +7736,20 @@ void unittest_test_pair(
 		(void)c;
 	}
 
+	/* score-only fill reports the same max and max pos */
+	_export(gaba_dp_set_fill_mode)(dp, GABA_FILL_SCORE_ONLY);
+	struct gaba_fill_s const *sm = unittest_dp_extend(dp, s);
+	_export(gaba_dp_set_fill_mode)(dp, GABA_FILL_FULL);
+
+	assert(sm != NULL);
+	assert(sm->max == m->max, FMT ", sm->max(%ld), m->max(%ld)", ARG, sm->max, m->max);
+
+	struct gaba_pos_pair_s const *sp = _export(gaba_dp_search_max)(dp, sm);
+	assert(sp != NULL);
+	assert(sp->aid == p->aid && sp->apos == p->apos, FMT ", a(%u, %u), (%u, %u)", ARG, sp->aid, sp->apos, p->aid, p->apos);
+	assert(sp->bid == p->bid && sp->bpos == p->bpos, FMT ", b(%u, %u), (%u, %u)", ARG, sp->bid, sp->bpos, p->bid, p->bpos);
+	assert(_export(gaba_dp_trace)(dp, sm, NULL) == NULL, FMT, ARG);
+
 	/* cleanup everything */
 	unittest_clean_section(s);
 	free(a);
@@ -5239,6 +7764,12 @@ void unittest_test_pair(
 	#undef ARG
 }
 
+/*
+ * "base" and "score" compare the kernels with the naive dp. the adaptive band misses the optimal
+ * path on a few of the random pairs under the preset scores (in the generic kernels as well), so
+ * the preset kernels are tested by "preset" and the self-consistency tests ("batch", ...) instead.
+ */
+#ifndef PRESET
 unittest( .name = "base", .params = &unittest_default_params[5] )
 {
 	struct unittest_seq_pair_s pairs[] = {
@@ -5537,6 +8068,7 @@ unittest( .name = "base", .params = &unittest_default_params[5] )
 		_export(gaba_clean)(g);
 	}
 }
+#endif /* !PRESET */
 
 /**
  * @fn unittest_random_base
@@ -5603,6 +8135,590 @@ char *unittest_generate_mutated_sequence(
 	return(mutated_seq);
 }
 
+#ifndef PRESET		/* see "base" */
+unittest( .name = "score" )
+{
+	uint64_t const cnt = 50;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	for(uint64_t i = 0; i < cnt; i++) {
+		/* long enough to wrap the block ring around in the score-only fill */
+		struct unittest_seq_pair_s pair = {
+			.a = {
+				unittest_generate_random_sequence((rand() % 2048) + 1),
+				unittest_generate_random_sequence((rand() % (_W + 10)) + 1),
+				unittest_generate_random_sequence((rand() % 2048) + 1)
+			}
+		};
+		for(uint64_t j = 0; pair.a[j] != NULL; j++) {
+			pair.b[j] = unittest_generate_mutated_sequence(pair.a[j], 0.1, 0.1, _W);
+		}
+
+		_export(gaba_dp_flush)(c->dp);
+		unittest_test_pair(UNITTEST_ARG_LIST, c->params, c->dp, &pair, 0);
+		unittest_test_pair(UNITTEST_ARG_LIST, c->params, c->dp, &pair, 1);
+
+		for(uint64_t j = 0; pair.a[j] != NULL; j++) {
+			free((void *)pair.a[j]);
+			free((void *)pair.b[j]);
+		}
+	}
+}
+#endif /* !PRESET */
+
+#ifdef PRESET
+unittest( .name = "preset" )
+{
+	struct gaba_params_s const *p = unittest_default_params[0];
+	struct gaba_score_vec_s sc = gaba_init_score_vector(p);
+
+	/* the immediates must be the same as the vectors built from the params */
+	assert(memcmp(sc.v1, preset_sb, 16) == 0);
+	assert(_ext_n(_load_adjh(sc), 0) == PRESET_GI, "%d", _ext_n(_load_adjh(sc), 0));
+	assert(_ext_n(_load_ofsh(sc), 0) == -p->gi - p->ge, "%d", _ext_n(_load_ofsh(sc), 0));
+}
+#endif
+
+unittest( .name = "screened" )
+{
+	uint64_t const cnt = 50;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		struct unittest_seq_pair_s pair = {
+			.a = { unittest_generate_random_sequence((rand() % 2048) + 1) }
+		};
+		pair.b[0] = unittest_generate_mutated_sequence(pair.a[0], 0.1, 0.1, _W);
+		_export(gaba_dp_flush)(dp);
+
+		/* reference: extension with traceback */
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		struct gaba_alignment_s const *r = _export(gaba_dp_trace)(dp, unittest_dp_extend(dp, s), NULL);
+		assert(r != NULL);
+
+		/* rejected extension leaves nothing on the stack */
+		uint8_t const *top = _restore_dp_context(dp)->stack.top;
+		struct gaba_alignment_s const *x = _export(gaba_dp_extend_screened)(dp,
+			&s->a[0], s->apos, &s->b[0], s->bpos, &s->a[1], r->score + 1, NULL
+		);
+		assert(x == NULL);
+		assert(_restore_dp_context(dp)->stack.top == top);
+		assert(_restore_dp_context(dp)->fmode == GABA_FILL_FULL);
+
+		/* accepted extension is traced */
+		struct gaba_alignment_s const *y = _export(gaba_dp_extend_screened)(dp,
+			&s->a[0], s->apos, &s->b[0], s->bpos, &s->a[1], r->score, NULL
+		);
+		assert(y != NULL);
+		assert(y->score == r->score, "score(%ld, %ld)", y->score, r->score);
+		assert(y->plen == r->plen, "plen(%lu, %lu)", y->plen, r->plen);
+
+		unittest_clean_section(s);
+		free((void *)pair.a[0]);
+		free((void *)pair.b[0]);
+	}
+}
+
+unittest( .name = "banded" )
+{
+	uint64_t const cnt = 50;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		struct unittest_seq_pair_s pair = {
+			.a = { unittest_generate_random_sequence((rand() % 2048) + 1) }
+		};
+		pair.b[0] = unittest_generate_mutated_sequence(pair.a[0], 0.1, 0.1, _W);
+		_export(gaba_dp_flush)(dp);
+
+		/* reference: extension with traceback */
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		struct gaba_fill_s const *m = unittest_dp_extend(dp, s);
+		struct gaba_alignment_s const *r = _export(gaba_dp_trace)(dp, m, NULL);
+		assert(r != NULL);
+		uint32_t const edge = m->status & GABA_BAND_EDGE;
+
+		/* rejected extension leaves nothing on the stack; accepted one is identical to the reference */
+		uint8_t const *top = _restore_dp_context(dp)->stack.top;
+		struct gaba_alignment_s const *x = _export(gaba_dp_extend_banded)(dp,
+			&s->a[0], s->apos, &s->b[0], s->bpos, &s->a[1], NULL
+		);
+		if(x == NULL) {
+			assert(_restore_dp_context(dp)->stack.top == top);
+		} else {
+			assert(edge == 0, "status(%x)", m->status);
+			assert(x->score == r->score, "score(%ld, %ld)", x->score, r->score);
+			assert(x->plen == r->plen, "plen(%lu, %lu)", x->plen, r->plen);
+		}
+
+		unittest_clean_section(s);
+		free((void *)pair.a[0]);
+		free((void *)pair.b[0]);
+	}
+}
+
+unittest( .name = "global" )
+{
+	uint64_t const cnt = 50;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		struct unittest_seq_pair_s pair = {
+			.a = { unittest_generate_random_sequence((rand() % 1024) + 1) }
+		};
+		pair.b[0] = unittest_generate_mutated_sequence(pair.a[0], 0.05, 0.05, _W / 4);
+		_export(gaba_dp_flush)(dp);
+
+		uint32_t const alen = strlen(pair.a[0]), blen = strlen(pair.b[0]);
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		struct gaba_alignment_s const *r = _export(gaba_dp_align_global)(dp,
+			&s->a[0], s->apos, s->apos + alen, &s->b[0], s->bpos, s->bpos + blen, NULL
+		);
+		assert(r != NULL);
+
+		/* the path spans the whole sequences, and the score is the same as the unbanded one */
+		int64_t const score = unittest_naive_score(c->params, pair.a[0], pair.b[0], 0);
+		assert(r->score == score, "score(%ld, %ld), len(%u, %u)", r->score, score, alen, blen);
+		assert(r->plen == alen + blen, "plen(%lu, %u, %u)", r->plen, alen, blen);
+		assert(r->slen >= 1 && r->seg[0].apos == s->apos && r->seg[0].bpos == s->bpos,
+			"pos(%u, %u), (%u, %u)", r->seg[0].apos, r->seg[0].bpos, s->apos, s->bpos
+		);
+		assert(_restore_dp_context(dp)->fmode == GABA_FILL_FULL);
+
+		unittest_clean_section(s);
+		free((void *)pair.a[0]);
+		free((void *)pair.b[0]);
+	}
+}
+
+unittest( .name = "local" )
+{
+	uint64_t const cnt = 50;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		/* unrelated prefixes (misplaced seed) followed by a homologous pair */
+		uint64_t const plen = rand() % 8;
+		char *core = unittest_generate_random_sequence((rand() % 1024) + 64);
+		char *mutated = unittest_generate_mutated_sequence(core, 0.02, 0.02, _W / 4);
+		char *pa = unittest_generate_random_sequence(plen), *pb = unittest_generate_random_sequence(plen);
+		char *a = malloc(plen + strlen(core) + 1), *b = malloc(plen + strlen(mutated) + 1);
+		strcpy(a, pa); strcat(a, core);
+		strcpy(b, pb); strcat(b, mutated);
+		struct unittest_seq_pair_s pair = { .a = { a }, .b = { b } };
+		_export(gaba_dp_flush)(dp);
+
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		struct gaba_alignment_s const *r = _export(gaba_dp_align_local)(dp,
+			&s->a[0], s->apos, &s->b[0], s->bpos, &s->a[1], NULL
+		);
+		assert(r != NULL);
+
+		/* the score is the Smith-Waterman one; the path starts at or after the root */
+		int64_t const score = unittest_naive_score(c->params, a, b, 1);
+		assert(r->score == score, "score(%ld, %ld), plen(%lu)", r->score, score, plen);
+		assert(r->slen == 0 || (r->seg[0].apos >= s->apos && r->seg[0].bpos >= s->bpos),
+			"pos(%u, %u), (%u, %u)", r->seg[0].apos, r->seg[0].bpos, s->apos, s->bpos
+		);
+		assert(_restore_dp_context(dp)->fmode == GABA_FILL_FULL);
+
+		unittest_clean_section(s);
+		free(a); free(b); free(pa); free(pb); free(core); free(mutated);
+	}
+}
+
+unittest( .name = "batch" )
+{
+	uint64_t const cnt = 20, len[3] = { 300, 300, 2048 };
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		/* short and long (continued out of the region) extensions mixed, odd count */
+		uint64_t const n = 2 * (i % 4) + 1;
+		struct unittest_seq_pair_s pair[7];
+		struct unittest_sec_pair_s *sec[7];
+		struct gaba_seed_s seed[7];
+		struct gaba_fill_s const *fill[7];
+		_export(gaba_dp_flush)(dp);
+		for(uint64_t j = 0; j < n; j++) {
+			pair[j] = (struct unittest_seq_pair_s){
+				.a = { unittest_generate_random_sequence((rand() % len[rand() % 3]) + 1) }
+			};
+			pair[j].b[0] = unittest_generate_mutated_sequence(pair[j].a[0], 0.1, 0.1, _W);
+			sec[j] = unittest_build_section(&pair[j], unittest_build_section_forward);
+			seed[j] = (struct gaba_seed_s){
+				.a = &sec[j]->a[0], .b = &sec[j]->b[0],
+				.apos = sec[j]->apos, .bpos = sec[j]->bpos
+			};
+		}
+		_export(gaba_dp_fill_root_batch)(dp, seed, n, 0, fill);
+
+		/* compare with the fill one by one */
+		for(uint64_t j = 0; j < n; j++) {
+			struct gaba_fill_s const *f = _export(gaba_dp_fill_root)(dp, seed[j].a, seed[j].apos, seed[j].b, seed[j].bpos, 0);
+			assert(fill[j] != NULL);
+			assert(fill[j]->max == f->max, "j(%lu), max(%ld, %ld)", j, fill[j]->max, f->max);
+			assert(fill[j]->status == f->status, "j(%lu), status(%x, %x)", j, fill[j]->status, f->status);
+			assert(fill[j]->apos == f->apos && fill[j]->bpos == f->bpos, "j(%lu), pos(%lu, %lu), (%lu, %lu)",
+				j, fill[j]->apos, fill[j]->bpos, f->apos, f->bpos);
+
+			struct gaba_alignment_s const *x = _export(gaba_dp_trace)(dp, fill[j], NULL);
+			struct gaba_alignment_s const *r = _export(gaba_dp_trace)(dp, f, NULL);
+			assert(x != NULL && r != NULL);
+			assert(x->score == r->score, "j(%lu), score(%ld, %ld)", j, x->score, r->score);
+			assert(x->plen == r->plen, "j(%lu), plen(%lu, %lu)", j, x->plen, r->plen);
+			assert(memcmp(x->path, r->path, sizeof(uint32_t) * ((x->plen + 31) / 32)) == 0, "j(%lu)", j);
+		}
+
+		for(uint64_t j = 0; j < n; j++) {
+			unittest_clean_section(sec[j]);
+			free((void *)pair[j].a[0]);
+			free((void *)pair[j].b[0]);
+		}
+	}
+}
+
+unittest( .name = "fill_batch" )
+{
+	uint64_t const cnt = 10, n = 19;
+
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+	struct gaba_dp_context_s *dp = c->dp;
+	for(uint64_t i = 0; i < cnt; i++) {
+		/* forward and reverse-complemented sections mixed, more than a chunk */
+		struct unittest_seq_pair_s pair[n];
+		struct unittest_sec_pair_s *sec[n];
+		struct gaba_seed_s seed[n];
+		struct gaba_fill_s const *max[n];
+		_export(gaba_dp_flush)(dp);
+		for(uint64_t j = 0; j < n; j++) {
+			pair[j] = (struct unittest_seq_pair_s){
+				.a = { unittest_generate_random_sequence((rand() % 1024) + 1) }
+			};
+			pair[j].b[0] = unittest_generate_mutated_sequence(pair[j].a[0], 0.1, 0.1, _W);
+			sec[j] = unittest_build_section(&pair[j],
+				rand() % 2 ? unittest_build_section_forward : unittest_build_section_reverse
+			);
+			seed[j] = (struct gaba_seed_s){
+				.a = &sec[j]->a[0], .b = &sec[j]->b[0],
+				.apos = sec[j]->apos, .bpos = sec[j]->bpos,
+				.tail = &sec[j]->a[1]
+			};
+		}
+		_export(gaba_dp_fill_batch)(dp, seed, n, max);
+
+		/* compare with the extension loop */
+		for(uint64_t j = 0; j < n; j++) {
+			struct gaba_fill_s const *m = unittest_dp_extend(dp, sec[j]);
+			assert(max[j] != NULL);
+			assert(max[j]->max == m->max, "j(%lu), max(%ld, %ld)", j, max[j]->max, m->max);
+
+			struct gaba_alignment_s const *x = _export(gaba_dp_trace)(dp, max[j], NULL);
+			struct gaba_alignment_s const *r = _export(gaba_dp_trace)(dp, m, NULL);
+			assert(x != NULL && r != NULL);
+			assert(x->score == r->score, "j(%lu), score(%ld, %ld)", j, x->score, r->score);
+			assert(x->plen == r->plen, "j(%lu), plen(%lu, %lu)", j, x->plen, r->plen);
+			assert(memcmp(x->path, r->path, sizeof(uint32_t) * ((x->plen + 31) / 32)) == 0, "j(%lu)", j);
+		}
+
+		for(uint64_t j = 0; j < n; j++) {
+			unittest_clean_section(sec[j]);
+			free((void *)pair[j].a[0]);
+			free((void *)pair[j].b[0]);
+		}
+	}
+}
+
+/* X-drop thresholds above 127 are accepted only by the 16-bit kernels */
+unittest( .name = "xdrop" )
+{
+	struct gaba_params_s p = *unittest_default_params[0];
+	p.xdrop = 1000;
+	if(p.gi != 0) {
+		/* gaps longer than mismatches, to keep the path on the diagonal through the stretch below */
+		p.ge = 3;
+		p.gfa = p.gfa != 0 ? 4 : 0;
+		p.gfb = p.gfb != 0 ? 4 : 0;
+	}
+	struct gaba_context_s *g = _export(gaba_init)(&p);
+#if DIFF == 8
+	assert(g == NULL);
+#else
+	assert(g != NULL);
+
+	/* 200 matches, a stretch of 60 mismatches (costs 180 on the diagonal), and 200 matches */
+	char *m = unittest_generate_random_sequence(200), *n = unittest_generate_random_sequence(200);
+	char x[61], y[61];
+	for(uint64_t i = 0; i < 60; i++) {
+		x[i] = (rand() & 0x01) ? 'A' : 'C';		/* no shift of x and y has a match */
+		y[i] = (rand() & 0x01) ? 'G' : 'T';
+	}
+	x[60] = y[60] = '\0';
+	struct unittest_seq_pair_s pair = { .a = { m, x, n }, .b = { m, y, n } };
+	struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+
+	/* the extension passes through the stretch */
+	struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+	struct gaba_fill_s const *f = unittest_dp_extend(l, s);
+	assert(f->max > 400, "%ld", f->max);
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+
+	/* and terminates inside it with the 8-bit threshold */
+	p.xdrop = 100;
+	g = _export(gaba_init)(&p);
+	l = _export(gaba_dp_init)(g);
+	f = unittest_dp_extend(l, s);
+	assert(f->max == 400, "%ld", f->max);
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+
+	unittest_clean_section(s);
+	free(m); free(n);
+#endif
+}
+
+#ifndef PRESET		/* the preset kernels ignore the gap penalties modified in the test */
+/* returns the last fill of the extension (unittest_dp_extend returns the max one) */
+static
+struct gaba_fill_s const *unittest_dp_extend_last(
+	struct gaba_dp_context_s *dp,
+	struct unittest_sec_pair_s *p)
+{
+	struct gaba_section_s const *a = p->a, *b = p->b;
+	struct gaba_fill_s const *f = _export(gaba_dp_fill_root)(dp, a, p->apos, b, p->bpos, 0);
+	while((f->status & GABA_TERM) == 0) {
+		a += (f->status & GABA_UPDATE_A) != 0;
+		b += (f->status & GABA_UPDATE_B) != 0;
+		if(a->base == NULL || b->base == NULL) { break; }
+		f = _export(gaba_dp_fill)(dp, f, a, b, 0);
+	}
+	return(f);
+}
+
+unittest( .name = "zdrop" )
+{
+	struct gaba_params_s p = *unittest_default_params[0];
+	p.xdrop = BLK == 32 ? 120 : 240;			/* the stretch below spans a block, sampled once by the Z-drop test */
+	if(p.gi != 0) {
+		/* gaps longer than mismatches, to keep the path on the diagonal through the stretch below */
+		p.ge = 3;
+		p.gfa = p.gfa != 0 ? 4 : 0;
+		p.gfb = p.gfb != 0 ? 4 : 0;
+	}
+
+	/* 200 matches, a stretch of BLK - 2 mismatches (costs 90 or 186 on the diagonal), and 200 matches */
+	char *m = unittest_generate_random_sequence(200), *n = unittest_generate_random_sequence(200);
+	char x[BLK - 1], y[BLK - 1];
+	for(uint64_t i = 0; i < BLK - 2; i++) {
+		x[i] = (rand() & 0x01) ? 'A' : 'C';		/* no shift of x and y has a match */
+		y[i] = (rand() & 0x01) ? 'G' : 'T';
+	}
+	x[BLK - 2] = y[BLK - 2] = '\0';
+	struct unittest_seq_pair_s pair = { .a = { m, x, n }, .b = { m, y, n } };
+	struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+
+	/* 200 matches, 6-base insertion (costs more than the Z-drop threshold), and 200 matches */
+	struct unittest_seq_pair_s gpair = { .a = { m, "ACGTAC", n }, .b = { m, n } };
+	struct unittest_sec_pair_s *t = unittest_build_section(&gpair, unittest_build_section_forward);
+
+	/* X-drop passes through the stretch */
+	struct gaba_context_s *g = _export(gaba_init)(&p);
+	struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+	struct gaba_fill_s const *f = unittest_dp_extend_last(l, s);
+	assert(f->max > 400, "%ld", f->max);
+	assert((f->status & GABA_ZDROP) == 0, "%x", f->status);
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+
+	/* Z-drop terminates inside the stretch, but not on the insertion (discounted by the gap length; terminates in the random tails) */
+	p.zdrop = 20;
+	g = _export(gaba_init)(&p);
+	l = _export(gaba_dp_init)(g);
+	f = unittest_dp_extend_last(l, s);
+	assert(f->max == 400, "%ld", f->max);
+	assert((f->status & (GABA_TERM | GABA_ZDROP)) == (GABA_TERM | GABA_ZDROP), "%x", f->status);
+	_export(gaba_dp_flush)(l);
+	f = unittest_dp_extend(l, t);
+	assert(f->max > 700, "%ld", f->max);
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+
+	unittest_clean_section(s);
+	unittest_clean_section(t);
+	free(m); free(n);
+}
+
+unittest( .name = "xdrop_resume" )
+{
+	struct gaba_params_s p = *unittest_default_params[0];
+	p.xdrop = 30;
+	if(p.gi != 0) {
+		/* gaps longer than mismatches, as in the zdrop test */
+		p.ge = 3;
+		p.gfa = p.gfa != 0 ? 4 : 0;
+		p.gfb = p.gfb != 0 ? 4 : 0;
+	}
+
+	/* 200 matches, a stretch of 30 mismatches (costs 90 on the diagonal), and 200 matches */
+	char *m = unittest_generate_random_sequence(200), *n = unittest_generate_random_sequence(200);
+	char x[31], y[31];
+	for(uint64_t i = 0; i < 30; i++) {
+		x[i] = (rand() & 0x01) ? 'A' : 'C';
+		y[i] = (rand() & 0x01) ? 'G' : 'T';
+	}
+	x[30] = y[30] = '\0';
+	struct unittest_seq_pair_s pair = { .a = { m, x, n }, .b = { m, y, n } };
+	struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+
+	struct gaba_context_s *g = _export(gaba_init)(&p);
+	struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+
+	/* the strict threshold terminates inside the stretch */
+	struct gaba_section_s const *a = s->a, *b = s->b;
+	struct gaba_fill_s const *f = _export(gaba_dp_fill_root)(l, a, s->apos, b, s->bpos, 0);
+	while((f->status & GABA_TERM) == 0) {
+		a += (f->status & GABA_UPDATE_A) != 0;
+		b += (f->status & GABA_UPDATE_B) != 0;
+		if(a->base == NULL || b->base == NULL) { break; }
+		f = _export(gaba_dp_fill)(l, f, a, b, 0);
+	}
+	assert((f->status & GABA_TERM) != 0, "%x", f->status);
+	assert(f->max == 400, "%ld", f->max);
+
+	/* out-of-range thresholds are rejected */
+	assert(_export(gaba_dp_set_xdrop)(l, 0) == -1);
+	assert(_export(gaba_dp_set_xdrop)(l, XDROP_MAX + 1) == -1);
+
+	/* the relaxed threshold resumes the extension from the terminated tail, reaching the max of the extension from the root */
+	assert(_export(gaba_dp_set_xdrop)(l, XDROP_MAX) == 30);
+	int64_t max = f->max;
+	do {
+		/* the terminated fill may have consumed a section as well */
+		a += (f->status & GABA_UPDATE_A) != 0;
+		b += (f->status & GABA_UPDATE_B) != 0;
+		if(a->base == NULL || b->base == NULL) { break; }
+		f = _export(gaba_dp_fill)(l, f, a, b, 0);
+		max = MAX2(max, f->max);
+	} while((f->status & GABA_TERM) == 0);
+	int64_t rmax = unittest_dp_extend(l, s)->max;
+	assert(max > 400, "%ld", max);
+	assert(max == rmax, "%ld, %ld", max, rmax);
+
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+	unittest_clean_section(s);
+	free(m); free(n);
+}
+
+unittest( .name = "end_bonus" )
+{
+	struct gaba_params_s p = *unittest_default_params[0];
+
+	for(uint64_t i = 0; i < 20; i++) {
+		/* the terminal section of b (or a) ends with a few mismatches, the other sequence continues */
+		char *m = unittest_generate_random_sequence(200), *n = unittest_generate_random_sequence(200);
+		char y[5];
+		for(uint64_t j = 0; j < 4; j++) { y[j] = n[j] == 'A' ? 'C' : 'A'; }
+		y[1 + rand() % 4] = '\0';
+		struct unittest_seq_pair_s pair = (i & 0x01)
+			? (struct unittest_seq_pair_s){ .a = { m, y }, .b = { m, n } }
+			: (struct unittest_seq_pair_s){ .a = { m, n }, .b = { m, y } };
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		if(i & 0x01) { s->a[1].id |= GABA_TERMINAL; } else { s->b[1].id |= GABA_TERMINAL; }
+		char *a = unittest_cat_seq(pair.a), *b = unittest_cat_seq(pair.b);
+
+		/* the max without the bonus clips the mismatches */
+		p.end_bonus = 0;
+		struct gaba_context_s *g = _export(gaba_init)(&p);
+		struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+		int64_t const max = unittest_dp_extend(l, s)->max;
+		_export(gaba_dp_clean)(l);
+		_export(gaba_clean)(g);
+
+		/* the bonus moves the max to the end of the terminal section if it pays for the mismatches */
+		p.end_bonus = (i & 0x02) ? 127 : 1;
+		g = _export(gaba_init)(&p);
+		l = _export(gaba_dp_init)(g);
+		struct gaba_fill_s const *f = unittest_dp_extend(l, s);
+		int64_t const emax = MAX2(max, unittest_naive_score(&p, a, b, 2) + p.end_bonus);
+		assert(f->max == emax, "max(%ld, %ld), bonus(%d)", f->max, emax, p.end_bonus);
+
+		struct gaba_alignment_s const *r = _export(gaba_dp_trace)(l, f, NULL);
+		struct gaba_segment_s const *t = &r->seg[r->slen - 1];
+		assert(r->score == f->max, "%ld, %ld", r->score, f->max);
+		if(f->max != max) {
+			assert((i & 0x01)
+				? t->aid == s->a[1].id && t->apos + t->alen == s->a[1].len
+				: t->bid == s->b[1].id && t->bpos + t->blen == s->b[1].len,
+				"seg(%u, %u, %u, %u)", t->apos, t->alen, t->bpos, t->blen
+			);
+		}
+		_export(gaba_dp_clean)(l);
+		_export(gaba_clean)(g);
+
+		unittest_clean_section(s);
+		free(a); free(b); free(m); free(n);
+	}
+}
+
+unittest( .name = "steer" )
+{
+	struct gaba_params_s p = *unittest_default_params[0];
+
+	for(uint64_t k = GABA_STEER_EDGE; k <= GABA_STEER_DAMPED; k++) {
+		p.steer = k;
+		struct gaba_context_s *g = _export(gaba_init)(&p);
+		struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+
+		for(uint64_t i = 0; i < 20; i++) {
+			/* the band only moves; the max never exceeds the local one and the path is traced as usual (or NULL if it got lost out of the band) */
+			char *m = unittest_generate_random_sequence(500);
+			char *n = unittest_generate_mutated_sequence(m, 0.1, 0.1, _W / 2);
+			struct unittest_seq_pair_s pair = { .a = { m }, .b = { n } };
+			struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+
+			struct gaba_fill_s const *f = unittest_dp_extend(l, s);
+			int64_t const score = unittest_naive_score(&p, m, n, 1);
+			assert(f->max <= score, "steer(%lu), max(%ld, %ld)", k, f->max, score);
+
+			struct gaba_alignment_s const *r = _export(gaba_dp_trace)(l, f, NULL);
+			assert(r == NULL || r->score == f->max, "steer(%lu), score(%ld, %ld)", k, r->score, f->max);
+
+			_export(gaba_dp_flush)(l);
+			unittest_clean_section(s);
+			free(m); free(n);
+		}
+		_export(gaba_dp_clean)(l);
+		_export(gaba_clean)(g);
+	}
+
+	/* the anchor keeps the band on the diagonal of the root (default), or pulls it off the matching diagonal */
+	p.steer = GABA_STEER_ANCHOR;
+	struct gaba_context_s *g = _export(gaba_init)(&p);
+	struct gaba_dp_context_s *l = _export(gaba_dp_init)(g);
+	char *m = unittest_generate_random_sequence(500);
+	struct unittest_seq_pair_s pair = { .a = { m }, .b = { m } };
+	struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+
+	int64_t const score = unittest_naive_score(&p, m, m, 1);
+	assert(unittest_dp_extend(l, s)->max == score, "%ld", score);
+	assert(_export(gaba_dp_set_anchor)(l, 4 * _W) == 0);
+	assert(unittest_dp_extend(l, s)->max < score, "%ld", score);
+	assert(_export(gaba_dp_set_anchor)(l, 0) == 4 * _W);
+
+	_export(gaba_dp_clean)(l);
+	_export(gaba_clean)(g);
+	unittest_clean_section(s);
+	free(m);
+}
+#endif /* !PRESET */
+
 unittest( .name = "cross" )
 {
 	uint64_t const cnt = 5000;
@@ -5646,6 +8762,56 @@ unittest( .name = "cross" )
 	}
 }
 
+unittest( .name = "convert" )
+{
+	struct unittest_context_s *c = (struct unittest_context_s *)gctx;
+
+	for(uint64_t i = 0; i < 500; i++) {
+		struct unittest_seq_pair_s pair = { .a = { NULL } };
+		for(uint64_t j = 0; j < 6; j++) {
+			pair.a[j] = unittest_generate_random_sequence((rand() % 256) + 1);
+			pair.b[j] = unittest_generate_mutated_sequence(pair.a[j], 0.1, 0.1, _W);
+		}
+		struct unittest_sec_pair_s *s = unittest_build_section(&pair, unittest_build_section_forward);
+		_export(gaba_dp_flush)(c->dp);
+		struct gaba_fill_s const *e = unittest_dp_extend(c->dp, s);
+		struct gaba_alignment_s const *t = _export(gaba_dp_trace)(c->dp, e, NULL);
+
+		/* the same extension converted to the same band width at random, resulting in the same max and path */
+		struct gaba_section_s const *a = s->a, *b = s->b;
+		struct gaba_fill_s const *f = _export(gaba_dp_fill_root)(c->dp, a, s->apos, b, s->bpos, 0), *m = f;
+		while((f->status & GABA_TERM) == 0) {
+			a += (f->status & GABA_UPDATE_A) != 0;
+			b += (f->status & GABA_UPDATE_B) != 0;
+			if(a->base == NULL || b->base == NULL) { break; }
+			if(rand() & 0x01) {
+				void const *band = _export(gaba_dp_export_band)(c->dp, f);
+				struct gaba_fill_s const *cf = band == NULL ? NULL : _export(gaba_dp_import_band)(c->dp, band, a, b);
+				f = cf != NULL ? cf : f;
+			}
+			f = _export(gaba_dp_fill)(c->dp, f, a, b, 0);
+			m = f->max > m->max ? f : m;
+		}
+		assert(m->max == e->max, "%ld, %ld", m->max, e->max);
+
+		struct gaba_pos_pair_s const *p = _export(gaba_dp_search_max)(c->dp, m), *q = _export(gaba_dp_search_max)(c->dp, e);
+		assert(p->apos == q->apos && p->bpos == q->bpos, "(%u, %u), (%u, %u)", p->apos, p->bpos, q->apos, q->bpos);
+
+		struct gaba_alignment_s const *r = _export(gaba_dp_trace)(c->dp, m, NULL);
+		assert(r != NULL);
+		assert(r->score == t->score, "%ld, %ld", r->score, t->score);
+		assert(r->plen == t->plen, "%lu, %lu", r->plen, t->plen);
+		assert(r->slen == t->slen, "%u, %u", r->slen, t->slen);
+		assert(strcmp(unittest_decode_path(r), unittest_decode_path(t)) == 0);
+
+		unittest_clean_section(s);
+		for(uint64_t j = 0; pair.a[j] != NULL; j++) {
+			free((void *)pair.a[j]);
+			free((void *)pair.b[j]);
+		}
+	}
+}
+
 #endif /* UNITTEST */
 
 /**
@@ -45,10 +45,34 @@ enum gaba_status {
 	GABA_CONT 		= 0,		/* continue, call again the function with the same args (but rarely occurrs) */
 	GABA_UPDATE_A 	= 0x000f,	/* update required on section a (always combined with GABA_UPDATE) */
 	GABA_UPDATE_B 	= 0x00f0,	/* update required on section b (always combined with GABA_UPDATE) */
-	GABA_TERM		= 0x8000,	/* extension terminated by X-drop */
+	GABA_TERM		= 0x8000,	/* extension terminated by X-drop (or Z-drop) */
+	GABA_ZDROP		= 0x1000,	/* terminated by Z-drop (always combined with GABA_TERM) */
+	GABA_BAND_EDGE	= 0x0200,	/* the max is on the edge lanes of the band (a wider band may find a better path) */
 	GABA_OOM		= 0x0400	/* out of memory (indicates malloc returned NULL) */
 };
 
+/**
+ * @enum gaba_fill_mode
+ * @brief GABA_FILL_SCORE_ONLY skips storing traceback masks; the max score and its position
+ * (gaba_dp_search_max) are available but gaba_dp_trace and gaba_dp_merge return NULL.
+ */
+enum gaba_fill_mode {
+	GABA_FILL_FULL			= 0,	/* store all the traceback masks (default) */
+	GABA_FILL_SCORE_ONLY	= 1		/* score and max position only, with O(1) memory per extension */
+};
+
+/**
+ * @enum gaba_steer
+ * @brief policy of the adaptive band, which decides at each vector whether the band goes down or right.
+ * it only moves the band; the scores of the cells inside the band are the same for all the policies.
+ */
+enum gaba_steer {
+	GABA_STEER_EDGE			= 0,	/* compare the score gains on the two edge lanes (default) */
+	GABA_STEER_MAX			= 1,	/* move the lane of the best score to the center, taken at the end of each block */
+	GABA_STEER_ANCHOR		= 2,	/* edge policy, kept within a quarter of the band width from the anchor diagonal (gaba_dp_set_anchor) */
+	GABA_STEER_DAMPED		= 3		/* edge policy with hysteresis: turns when the opposite gain exceeds a gap open (gi + ge) */
+};
+
 /**
  * @type gaba_lmalloc_t, gaba_free_t
  * @brief external malloc can be passed, otherwise system malloc will be used
@@ -79,20 +103,24 @@ typedef struct gaba_alloc_s gaba_alloc_t;
  */
 struct gaba_params_s {
 	/** scoring parameters */
-	int8_t score_matrix[16];	/** score matrix (substitution matrix) max must not exceed 7 */
+	int8_t score_matrix[16];	/** score matrix (substitution matrix) max must not exceed 7 (larger ones are handled by the 16-bit kernels) */
 	int8_t gi;					/** gap open penalty (0 for the linear-gap penalty; positive integer) */
 	int8_t ge;					/** gap extension penalty (positive integer) */
 	int8_t gfa, gfb;			/** linear-gap extension penalty for short indels (combined-gap penalty; gf > ge). gfa for gaps on sequence A, gfb for seq. B. */
 
 	/** score parameters */
-	int8_t xdrop;				/** X-drop threshold, positive, less than 128 */
+	int16_t xdrop;				/** X-drop threshold, positive; values above 127 are handled by the 16-bit kernels */
+	int16_t zdrop;				/** Z-drop threshold, positive (zero to disable): terminates when the best cell of the band drops from the max by more than zdrop + ge * (diagonal distance from the max) */
+	int16_t end_bonus;			/** end bonus, in [0, 127] (zero to disable): added to the score of the cell on the last row or column of a GABA_TERMINAL section */
 
 	/** filtering parameters */
 	uint8_t filter_thresh;		/** popcnt filter threshold, set zero if you want to disable it */
 
+	/** band steering */
+	uint8_t steer;				/** steering policy of the adaptive band (enum gaba_steer; GABA_STEER_EDGE by default) */
+
 	/* internal */
 	void *reserved;
-	uint64_t _pad;
 };
 typedef struct gaba_params_s gaba_params_t;
 
@@ -108,6 +136,22 @@ typedef struct gaba_params_s gaba_params_t;
  */
 #define GABA_SCORE_SIMPLE(_m, _x, _gi, _ge)	.score_matrix = { (_m),-(_x),-(_x),-(_x),-(_x),(_m),-(_x),-(_x),-(_x),-(_x),(_m),-(_x),-(_x),-(_x),-(_x),(_m) }, .gi = (_gi), .ge = (_ge)
 
+/**
+ * @macro GABA_PRESET_1, ..., GABA_SCORE_PRESET
+ * @brief scoring presets in (match award, mismatch penalty, gap open penalty, gap extension penalty).
+ * gaba_init picks the kernels specialized for a preset (the score constants are compile-time immediates)
+ * when the params are GABA_SCORE_PRESET(k), or the equivalent GABA_SCORE_SIMPLE, without gfa and gfb.
+ */
+#define GABA_PRESET_CNT				( 4 )
+#define GABA_PRESET_1				2, 3, 5, 1		/* the example and the benchmark */
+#define GABA_PRESET_2				1, 1, 1, 1		/* unit costs */
+#define GABA_PRESET_3				2, 4, 4, 2		/* minimap2 map-ont, the short-gap piece */
+#define GABA_PRESET_4				1, 4, 6, 2		/* minimap2 map-hifi, the short-gap piece */
+#define _gaba_preset_cat(x, y)		x##y
+#define _gaba_preset(_k)			_gaba_preset_cat(GABA_PRESET_, _k)
+#define _gaba_score_simple(...)		GABA_SCORE_SIMPLE(__VA_ARGS__)
+#define GABA_SCORE_PRESET(_k)		_gaba_score_simple(_gaba_preset(_k))
+
 /**
  * @type gaba_t
  *
@@ -138,6 +182,15 @@ typedef struct gaba_section_s gaba_section_t;
 		(_id), (_len), (uint8_t const *)(_base) \
 	} \
 )
+
+/**
+ * @macro GABA_TERMINAL
+ * @brief section id flag, marks the section ends at the end of the sequence. A fill that exhausts
+ * the section gives the end_bonus to the cell on its last row (b) or column (a); the max of the
+ * fill moves to the cell if the bonus makes it the best, and the alignment is traced from there.
+ * The flag is kept in the ids of the fill and the alignment segments.
+ */
+#define GABA_TERMINAL					( 0x80000000 )
 /**
  * @macro GABA_EOU
  * @brief end-of-userland pointer. Any input sequence pointer p that points to an address
@@ -148,6 +201,19 @@ typedef struct gaba_section_s gaba_section_t;
 #define GABA_EOU						( (uint8_t const *)0x800000000000 )
 #define gaba_mirror(base, len)			( GABA_EOU + (uint64_t)GABA_EOU - (uint64_t)(base) - (uint64_t)(len) )
 
+/**
+ * @struct gaba_seed_s
+ *
+ * @brief an extension problem of the batch fill: a pair of sections, the start positions, and the tail.
+ */
+struct gaba_seed_s {
+	gaba_section_t const *a;	/** (8) a-side (reference side) section */
+	gaba_section_t const *b;	/** (8) b-side (query) section */
+	uint32_t apos, bpos;		/** (8) start positions in the sections */
+	gaba_section_t const *tail;	/** (8) substituted for the sections reached the end (gaba_dp_fill_batch), NULL stops the extension there */
+};
+typedef struct gaba_seed_s gaba_seed_t;
+
 /* gaba_rev is deprecated */
 #define gaba_rev(pos, len)				( (len) + (uint64_t)(len) - (uint64_t)(pos) - 1 )
 
@@ -169,8 +235,9 @@ struct gaba_fill_s {
 	uint64_t apos, bpos;		/** (16) #fetched bases from the head (ppos = apos + bpos) */
 	int64_t max;				/** (8) max score in the entire band */
 	uint32_t status;			/** (4) status (section update flags) */
+	uint32_t bw;				/** (4) band width of the kernel that filled the band (see gaba_dp_convert) */
 	// int32_t ppos;				/** (8) #vectors from the head (FIXME: should be 64bit int) */
-	uint32_t reserved[5];
+	uint32_t reserved[4];
 };
 typedef struct gaba_fill_s gaba_fill_t;
 
@@ -267,6 +334,39 @@ _GABA_EXPORT_LEVEL
 void gaba_dp_flush(
 	gaba_dp_t *dp);
 
+/**
+ * @fn gaba_dp_set_fill_mode
+ * @brief set fill mode (GABA_FILL_FULL or GABA_FILL_SCORE_ONLY), returns the previous mode.
+ * the mode is read in gaba_dp_fill_root and inherited by the succeeding gaba_dp_fill calls.
+ */
+_GABA_EXPORT_LEVEL
+uint32_t gaba_dp_set_fill_mode(
+	gaba_dp_t *dp,
+	uint32_t mode);
+
+/**
+ * @fn gaba_dp_set_xdrop
+ * @brief set X-drop threshold of the succeeding gaba_dp_fill_root and gaba_dp_fill calls, returns
+ * the previous threshold (or -1 if xdrop is out of the range of the kernel, leaving it unchanged).
+ * a fill terminated by X-drop can be passed to gaba_dp_fill again after raising the threshold (with
+ * the sections advanced by its update flags); the extension resumes from the tail without refilling the blocks.
+ */
+_GABA_EXPORT_LEVEL
+int32_t gaba_dp_set_xdrop(
+	gaba_dp_t *dp,
+	int32_t xdrop);
+
+/**
+ * @fn gaba_dp_set_anchor
+ * @brief set the anchor diagonal (apos - bpos in the coordinates of gaba_fill_s) of the succeeding
+ * gaba_dp_fill_root and gaba_dp_fill calls, returns the previous one. read only in GABA_STEER_ANCHOR;
+ * zero (the default) keeps the band around the diagonal of the root.
+ */
+_GABA_EXPORT_LEVEL
+int64_t gaba_dp_set_anchor(
+	gaba_dp_t *dp,
+	int64_t diag);
+
 /**
  * @fn gaba_dp_save_stack
  */
@@ -301,6 +401,32 @@ gaba_fill_t *gaba_dp_fill_root(
 	uint32_t bpos,
 	uint32_t pridx);
 
+/**
+ * @fn gaba_dp_fill_root_batch
+ * @brief gaba_dp_fill_root for cnt independent seeds, the fill objects are stored in fill[0..cnt).
+ * 16-cell bands are filled two at a time, packed in the halves of a 32-cell vector.
+ */
+_GABA_EXPORT_LEVEL
+void gaba_dp_fill_root_batch(
+	gaba_dp_t *dp,
+	gaba_seed_t const *seed,
+	uint64_t cnt,
+	uint32_t pridx,
+	gaba_fill_t const **fill);
+
+/**
+ * @fn gaba_dp_fill_batch
+ * @brief extend cnt seeds until X-drop termination (the GABA_UPDATE loop of the example), the fill
+ * objects with the max are stored in max[0..cnt). seeds are processed in the order of the reference
+ * address, and the sequences of the next seeds are prefetched while the current ones are extended.
+ */
+_GABA_EXPORT_LEVEL
+void gaba_dp_fill_batch(
+	gaba_dp_t *dp,
+	gaba_seed_t const *seed,
+	uint64_t cnt,
+	gaba_fill_t const **max);
+
 /**
  * @fn gaba_dp_fill
  * @brief fill dp matrix inside section pairs
@@ -316,7 +442,7 @@ gaba_fill_t *gaba_dp_fill(
 /**
  * @fn gaba_dp_merge
  * @brief merge multiple sections. all the vectors (tail objects) must be aligned on the same ppos,
- * and qofs are the q-distance of the two fill objects.
+ * and qofs are the q-distance of the two fill objects. returns NULL on the 128- and 256-cell bands.
  */
 #define MAX_MERGE_COUNT				( 14 )
 _GABA_EXPORT_LEVEL
@@ -344,6 +470,110 @@ gaba_alignment_t *gaba_dp_trace(
 	gaba_fill_t const *tail,
 	gaba_alloc_t const *alloc);
 
+/**
+ * @fn gaba_dp_extend_screened
+ * @brief extend from (apos, bpos) of the sections until X-drop termination, substituting the tail
+ * section (e.g. an array of zeros) for the ones reached the end. the extension is first filled in
+ * the score-only mode, and traced (with the second fill) only when its max is at least threshold.
+ * returns NULL if rejected. the stack consumed in the first pass is released before returning.
+ */
+_GABA_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_screened(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	int64_t threshold,
+	gaba_alloc_t const *alloc);
+
+/**
+ * @fn gaba_dp_align_global
+ * @brief end-to-end (global) alignment of a[apos, aend) and b[bpos, bend) within the band. the band
+ * is filled without X-drop termination and steered to (aend, bend) once the center reaches either end;
+ * the path starts at (apos, bpos) and ends at (aend, bend), and aln->score is the score of the end
+ * cell. the difference of the two lengths must be small enough to be absorbed by the band. the
+ * sections must be followed by at least the band width of readable bytes (the tail section).
+ */
+_GABA_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_align_global(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	uint32_t aend,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	uint32_t bend,
+	gaba_alloc_t const *alloc);
+
+/**
+ * @fn gaba_dp_align_local
+ * @brief start-free extension from (apos, bpos): the path ends at the max of the extension and
+ * starts at the cell that maximizes the score to the end, so a negative prefix after a misplaced
+ * seed is clipped (the segments report the start). the sections and the tail are the same as
+ * gaba_dp_extend_screened. the start is searched on the reverse-complemented sequences, which gives
+ * the same scores on the substitution matrices symmetric under complement (e.g. GABA_SCORE_SIMPLE).
+ */
+_GABA_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_align_local(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc);
+
+/**
+ * @fn gaba_dp_extend_banded
+ * @brief extend and trace as gaba_dp_extend_screened (without the threshold), but returns NULL if the
+ * band looks too narrow: the max is on the edge lanes (GABA_BAND_EDGE), or the path visits the edge
+ * lanes or runs out of the band. the stack consumed by a rejected extension is released.
+ */
+_GABA_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_banded(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc);
+
+/**
+ * @fn gaba_dp_extend_adaptive
+ * @brief gaba_dp_extend_banded on the 16-cell band, then on the 32-cell band if rejected, and finally
+ * the extension on the 64-cell band traced unconditionally. dp must be the one returned by gaba_dp_init.
+ */
+_GABA_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_adaptive(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc);
+
+/**
+ * @fn gaba_dp_convert
+ * @brief convert the fill to the band width bw (16, 32, 64, 128, or 256) in the middle of the extension.
+ * lanes are added to (or removed from) the both sides of the band by moving the fronts on the sections,
+ * so a and b must be the sections that gaba_dp_fill would take next (or the finished ones again to move the
+ * fronts back on them; the next sections follow the status of the returned fill). the returned fill is passed to
+ * gaba_dp_fill, gaba_dp_search_max, and gaba_dp_trace on &dp[_gaba_dp_ctx_index(bw)]. dp must be the one
+ * returned by gaba_dp_init. returns NULL if the fill is the root, a bridge, a merged or just-converted one,
+ * or the sections are too short to move the fronts.
+ */
+_GABA_EXPORT_LEVEL
+gaba_fill_t *gaba_dp_convert(
+	gaba_dp_t *dp,
+	gaba_fill_t const *fill,
+	uint32_t bw,
+	gaba_section_t const *a,
+	gaba_section_t const *b);
+
 /**
  * @fn gaba_dp_res_free
  */
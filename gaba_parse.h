@@ -90,7 +90,7 @@ struct gaba_parse_dp_context_s {
 
 	/* scores */
 	float imx, xmx;						/** (8) 1 / (M - X), X / (M - X) (precalculated constants) */
-	int8_t tx;							/** (1) xdrop threshold */
+	int16_t tx;							/** (2) xdrop threshold */
 	int8_t tf;							/** (1) filter threshold */
 	int8_t gi, ge, gfa, gfb;			/** (4) negative integers */
 	uint8_t aflen, bflen;				/** (2) short-gap length thresholds */
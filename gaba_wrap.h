@@ -4,7 +4,7 @@
  *
  * @brief wrapper API implementation of the GABA library
  * gaba.c must be compiled with the following combinations:
- * {-DBW=16, -DBW=32} x {-DMODEL=LINEAR, -DMODEL=AFFINE}.
+ * {-DBW=16, -DBW=32, -DBW=64, -DBW=128, -DBW=256} x {-DMODEL=LINEAR, -DMODEL=AFFINE, -DMODEL=COMBINED}.
  *
  * @author Hajime Suzuki
  * @date 2016/6/1
@@ -33,7 +33,7 @@
  * @struct redefinition of gaba_dp_context_s
  * must be declared before gaba.h is included
  */
-typedef struct gaba_api_s gaba_dp_t;	/** (64) [0] for 32-cell, [1] for 16-cell */
+typedef struct gaba_api_s gaba_dp_t;	/** (128) indexed by _gaba_dp_ctx_index(bw) */
 
 
 #include <stdint.h>						/* uint32_t, uint64_t, ... */
@@ -48,9 +48,9 @@ typedef struct gaba_api_s gaba_dp_t;	/** (64) [0] for 32-cell, [1] for 16-cell *
 
 
 /* bandwidth-related macros (see gaba.c) */
-#define GABA_DP_CTX_MAX					( 3 )
+#define GABA_DP_CTX_MAX					( 5 )
 // #define _gaba_dp_ctx_index(_bw)			( GABA_DP_CTX_MAX - ((_bw)>>4) )
-#define _gaba_dp_ctx_index(_bw)			( ((_bw) == 64) ? 0 : (((_bw) == 32) ? 1 : 2) )
+#define _gaba_dp_ctx_index(_bw)			( ((_bw) <= 64) ? (((_bw) == 64) ? 0 : (((_bw) == 32) ? 1 : 2)) : (((_bw) == 128) ? 3 : 4) )
 _static_assert(_gaba_dp_ctx_index(64) == 0);		/* assume 64-cell has the smallest index */
 
 
@@ -66,6 +66,24 @@ _static_assert(_gaba_dp_ctx_index(64) == 0);		/* assume 64-cell has the smallest
 #endif
 
 
+/*
+ * instruction sets of the kernels. the Makefile builds all the kernels once per instruction
+ * set (with NAMESPACE=sse41, avx2, and avx512) and compiles this file with -DARCH_DISPATCH,
+ * so that gaba_init selects the widest set available on the running cpu.
+ */
+#define GABA_ARCH_SSE41				0
+#define GABA_ARCH_AVX2				1
+#define GABA_ARCH_AVX512			2
+#define GABA_ARCH_MAX				3
+#ifdef ARCH_DISPATCH
+#  define _import_arch_cat(x, y)	x##_##y
+#  define _import_arch_cat2(x, y)	_import_arch_cat(x, y)
+#  define _import_arch(_base, _arch)	_import_arch_cat2(_base, _arch)
+#else
+#  define _import_arch(_base, _arch)	_import(_base)		/* single instruction set */
+#endif
+
+
 /* gap penalty model (linear or affine) */
 #define GABA_LINEAR 				0
 #define GABA_AFFINE					1
@@ -110,9 +128,74 @@ struct gaba_api_s {
 		gaba_fill_t const *tail,
 		gaba_alloc_t const *alloc);
 
-	void *unused[3];
+	/* two-pass extension */
+	gaba_alignment_t *(*dp_extend_screened)(
+		gaba_dp_t *self,
+		gaba_section_t const *a,
+		uint32_t apos,
+		gaba_section_t const *b,
+		uint32_t bpos,
+		gaba_section_t const *tail,
+		int64_t threshold,
+		gaba_alloc_t const *alloc);
+
+	/* extension rejected if the band was too narrow */
+	gaba_alignment_t *(*dp_extend_banded)(
+		gaba_dp_t *self,
+		gaba_section_t const *a,
+		uint32_t apos,
+		gaba_section_t const *b,
+		uint32_t bpos,
+		gaba_section_t const *tail,
+		gaba_alloc_t const *alloc);
+
+	/* banded global alignment */
+	gaba_alignment_t *(*dp_align_global)(
+		gaba_dp_t *self,
+		gaba_section_t const *a,
+		uint32_t apos,
+		uint32_t aend,
+		gaba_section_t const *b,
+		uint32_t bpos,
+		uint32_t bend,
+		gaba_alloc_t const *alloc);
+
+	/* start-free extension */
+	gaba_alignment_t *(*dp_align_local)(
+		gaba_dp_t *self,
+		gaba_section_t const *a,
+		uint32_t apos,
+		gaba_section_t const *b,
+		uint32_t bpos,
+		gaba_section_t const *tail,
+		gaba_alloc_t const *alloc);
+
+	/* batch fill */
+	void (*dp_fill_root_batch)(
+		gaba_dp_t *self,
+		gaba_seed_t const *seed,
+		uint64_t cnt,
+		uint32_t pridx,
+		gaba_fill_t const **fill);
+	void (*dp_fill_batch)(
+		gaba_dp_t *self,
+		gaba_seed_t const *seed,
+		uint64_t cnt,
+		gaba_fill_t const **max);
+
+	/* band-width conversion */
+	void *(*dp_export_band)(
+		gaba_dp_t *self,
+		gaba_fill_t const *fill);
+	gaba_fill_t *(*dp_import_band)(
+		gaba_dp_t *self,
+		void const *band,
+		gaba_section_t const *a,
+		gaba_section_t const *b);
+
+	void *_reserved[3];
 };
-_static_assert(sizeof(struct gaba_api_s) == 8 * sizeof(void *));		/* must be consistent to gaba_opaque_s */
+_static_assert(sizeof(struct gaba_api_s) == 16 * sizeof(void *));		/* must be consistent to gaba_opaque_s */
 #define _api(_dp)				( (struct gaba_api_s const *)(_dp) )
 #define _api_array(_ctx)		( (struct gaba_api_s const (*)[GABA_DP_CTX_MAX])(_ctx) )
 
@@ -120,29 +203,50 @@ _static_assert(sizeof(struct gaba_api_s) == 8 * sizeof(void *));		/* must be con
 /* forward declarations */
 #define _decl_cat3_2(a, b, c)	a##_##b##_##c
 #define _decl_cat3(a, b, c)		_decl_cat3_2(a, b, c)
+#define _decl_arch(ret_t, _base, _arch, ...) \
+	ret_t _import_arch(_decl_cat3(_base, linear, 16), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, affine, 16), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, combined, 16), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, linear, 32), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, affine, 32), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, combined, 32), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, linear, 64), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, affine, 64), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, combined, 64), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, linear, 128), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, affine, 128), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, combined, 128), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, linear, 256), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, affine, 256), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, combined, 256), _arch)(__VA_ARGS__);
 #define _decl(ret_t, _base, ...) \
-	ret_t _import(_decl_cat3(_base, linear, 16))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, affine, 16))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, combined, 16))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, linear, 32))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, affine, 32))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, combined, 32))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, linear, 64))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, affine, 64))(__VA_ARGS__); \
-	ret_t _import(_decl_cat3(_base, combined, 64))(__VA_ARGS__);
+	_decl_arch(ret_t, _base, sse41, __VA_ARGS__) \
+	_decl_arch(ret_t, _base, avx2, __VA_ARGS__) \
+	_decl_arch(ret_t, _base, avx512, __VA_ARGS__)
 
 _decl(gaba_t *, gaba_init, gaba_params_t const *params);
 _decl(void, gaba_clean, gaba_t *ctx);
 _decl(gaba_dp_t *, gaba_dp_init, gaba_t const *ctx);
 _decl(void, gaba_dp_flush, gaba_dp_t *self);
+_decl(uint32_t, gaba_dp_set_fill_mode, gaba_dp_t *self, uint32_t mode);
+_decl(int32_t, gaba_dp_set_xdrop, gaba_dp_t *self, int32_t xdrop);
+_decl(int64_t, gaba_dp_set_anchor, gaba_dp_t *self, int64_t diag);
 _decl(gaba_stack_t const *, gaba_dp_save_stack, gaba_dp_t *self);
 _decl(void, gaba_dp_flush_stack, gaba_dp_t *self, gaba_stack_t const *stack);
 _decl(void, gaba_dp_clean, gaba_dp_t *self);
 _decl(gaba_fill_t *, gaba_dp_fill_root, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, uint32_t pridx);
+_decl(void, gaba_dp_fill_root_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, uint32_t pridx, gaba_fill_t const **fill);
+_decl(void, gaba_dp_fill_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, gaba_fill_t const **max);
 _decl(gaba_fill_t *, gaba_dp_fill, gaba_dp_t *self, gaba_fill_t const *prev_sec, gaba_section_t const *a, gaba_section_t const *b, uint32_t pridx);
 _decl(gaba_fill_t *, gaba_dp_merge, gaba_dp_t *self, gaba_fill_t const *const *sec, uint8_t const *qofs, uint32_t cnt);
 _decl(gaba_pos_pair_t *, gaba_dp_search_max, gaba_dp_t *self, gaba_fill_t const *sec);
 _decl(gaba_alignment_t *, gaba_dp_trace, gaba_dp_t *self, gaba_fill_t const *tail, gaba_alloc_t const *alloc);
+_decl(gaba_alignment_t *, gaba_dp_extend_screened, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, int64_t threshold, gaba_alloc_t const *alloc);
+_decl(gaba_alignment_t *, gaba_dp_extend_banded, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl(gaba_alignment_t *, gaba_dp_align_global, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, uint32_t aend, gaba_section_t const *b, uint32_t bpos, uint32_t bend, gaba_alloc_t const *alloc);
+_decl(gaba_alignment_t *, gaba_dp_align_local, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl(void *, gaba_dp_export_band, gaba_dp_t *self, gaba_fill_t const *fill);
+_decl(gaba_fill_t *, gaba_dp_import_band, gaba_dp_t *self, void const *band, gaba_section_t const *a, gaba_section_t const *b);
 _decl(void, gaba_dp_res_free, gaba_dp_t *dp, gaba_alignment_t *res);
 _decl(gaba_score_t *, gaba_dp_calc_score, gaba_dp_t *dp, uint32_t const *path, gaba_path_section_t const *s, gaba_section_t const *a, gaba_section_t const *b);
 // _decl(int64_t, gaba_dp_print_cigar_forward, gaba_dp_printer_t printer, void *fp, uint32_t const *path, uint32_t offset, uint32_t len);
@@ -150,7 +254,145 @@ _decl(gaba_score_t *, gaba_dp_calc_score, gaba_dp_t *dp, uint32_t const *path, g
 // _decl(int64_t, gaba_dp_dump_cigar_forward, char *buf, uint64_t buf_size, uint32_t const *path, uint32_t offset, uint32_t len);
 // _decl(int64_t, gaba_dp_dump_cigar_reverse, char *buf, uint64_t buf_size, uint32_t const *path, uint32_t offset, uint32_t len);
 
+/* kernels specialized for the scoring presets; the 16-, 32-, and 64-cell bands (see GABA_PRESET_* in gaba.h) */
+#define _decl_preset_bw(ret_t, _base, _preset, _arch, ...) \
+	ret_t _import_arch(_decl_cat3(_base, _preset, 16), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, _preset, 32), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, _preset, 64), _arch)(__VA_ARGS__);
+#define _decl_preset_arch(ret_t, _base, _arch, ...) \
+	_decl_preset_bw(ret_t, _base, preset1, _arch, __VA_ARGS__) \
+	_decl_preset_bw(ret_t, _base, preset2, _arch, __VA_ARGS__) \
+	_decl_preset_bw(ret_t, _base, preset3, _arch, __VA_ARGS__) \
+	_decl_preset_bw(ret_t, _base, preset4, _arch, __VA_ARGS__)
+#define _decl_preset(ret_t, _base, ...) \
+	_decl_preset_arch(ret_t, _base, sse41, __VA_ARGS__) \
+	_decl_preset_arch(ret_t, _base, avx2, __VA_ARGS__) \
+	_decl_preset_arch(ret_t, _base, avx512, __VA_ARGS__)
+
+_static_assert(GABA_PRESET_CNT == 4);
+_decl_preset(gaba_fill_t *, gaba_dp_fill_root, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, uint32_t pridx);
+_decl_preset(void, gaba_dp_fill_root_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, uint32_t pridx, gaba_fill_t const **fill);
+_decl_preset(void, gaba_dp_fill_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, gaba_fill_t const **max);
+_decl_preset(gaba_fill_t *, gaba_dp_fill, gaba_dp_t *self, gaba_fill_t const *prev_sec, gaba_section_t const *a, gaba_section_t const *b, uint32_t pridx);
+_decl_preset(gaba_fill_t *, gaba_dp_merge, gaba_dp_t *self, gaba_fill_t const *const *sec, uint8_t const *qofs, uint32_t cnt);
+_decl_preset(gaba_pos_pair_t *, gaba_dp_search_max, gaba_dp_t *self, gaba_fill_t const *sec);
+_decl_preset(gaba_alignment_t *, gaba_dp_trace, gaba_dp_t *self, gaba_fill_t const *tail, gaba_alloc_t const *alloc);
+_decl_preset(gaba_alignment_t *, gaba_dp_extend_screened, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, int64_t threshold, gaba_alloc_t const *alloc);
+_decl_preset(gaba_alignment_t *, gaba_dp_extend_banded, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl_preset(gaba_alignment_t *, gaba_dp_align_global, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, uint32_t aend, gaba_section_t const *b, uint32_t bpos, uint32_t bend, gaba_alloc_t const *alloc);
+_decl_preset(gaba_alignment_t *, gaba_dp_align_local, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl_preset(void *, gaba_dp_export_band, gaba_dp_t *self, gaba_fill_t const *fill);
+_decl_preset(gaba_fill_t *, gaba_dp_import_band, gaba_dp_t *self, void const *band, gaba_section_t const *a, gaba_section_t const *b);
+
+/* kernels with 16-bit difference lanes for the scoring schemes exceeding the 8-bit ones; the 16-, 32-, and 64-cell bands */
+#define _decl_diff16_bw(ret_t, _base, _model, _arch, ...) \
+	ret_t _import_arch(_decl_cat3(_base, _model, 16), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, _model, 32), _arch)(__VA_ARGS__); \
+	ret_t _import_arch(_decl_cat3(_base, _model, 64), _arch)(__VA_ARGS__);
+#define _decl_diff16_arch(ret_t, _base, _arch, ...) \
+	_decl_diff16_bw(ret_t, _base, linear16, _arch, __VA_ARGS__) \
+	_decl_diff16_bw(ret_t, _base, affine16, _arch, __VA_ARGS__) \
+	_decl_diff16_bw(ret_t, _base, combined16, _arch, __VA_ARGS__)
+#define _decl_diff16(ret_t, _base, ...) \
+	_decl_diff16_arch(ret_t, _base, sse41, __VA_ARGS__) \
+	_decl_diff16_arch(ret_t, _base, avx2, __VA_ARGS__) \
+	_decl_diff16_arch(ret_t, _base, avx512, __VA_ARGS__)
+
+_decl_diff16(gaba_t *, gaba_init, gaba_params_t const *params);
+_decl_diff16(gaba_fill_t *, gaba_dp_fill_root, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, uint32_t pridx);
+_decl_diff16(void, gaba_dp_fill_root_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, uint32_t pridx, gaba_fill_t const **fill);
+_decl_diff16(void, gaba_dp_fill_batch, gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, gaba_fill_t const **max);
+_decl_diff16(gaba_fill_t *, gaba_dp_fill, gaba_dp_t *self, gaba_fill_t const *prev_sec, gaba_section_t const *a, gaba_section_t const *b, uint32_t pridx);
+_decl_diff16(gaba_fill_t *, gaba_dp_merge, gaba_dp_t *self, gaba_fill_t const *const *sec, uint8_t const *qofs, uint32_t cnt);
+_decl_diff16(gaba_pos_pair_t *, gaba_dp_search_max, gaba_dp_t *self, gaba_fill_t const *sec);
+_decl_diff16(gaba_alignment_t *, gaba_dp_trace, gaba_dp_t *self, gaba_fill_t const *tail, gaba_alloc_t const *alloc);
+_decl_diff16(gaba_alignment_t *, gaba_dp_extend_screened, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, int64_t threshold, gaba_alloc_t const *alloc);
+_decl_diff16(gaba_alignment_t *, gaba_dp_extend_banded, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl_diff16(gaba_alignment_t *, gaba_dp_align_global, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, uint32_t aend, gaba_section_t const *b, uint32_t bpos, uint32_t bend, gaba_alloc_t const *alloc);
+_decl_diff16(gaba_alignment_t *, gaba_dp_align_local, gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc);
+_decl_diff16(void *, gaba_dp_export_band, gaba_dp_t *self, gaba_fill_t const *fill);
+_decl_diff16(gaba_fill_t *, gaba_dp_import_band, gaba_dp_t *self, void const *band, gaba_section_t const *a, gaba_section_t const *b);
+
 #undef _decl
+#undef _decl_arch
+#undef _decl_preset
+#undef _decl_preset_arch
+#undef _decl_preset_bw
+#undef _decl_diff16
+#undef _decl_diff16_arch
+#undef _decl_diff16_bw
+
+/**
+ * @fn gaba_dp_*_none
+ * @brief placeholders for the 128- and 256-cell bands of the 16-bit kernels, which are not built
+ */
+static
+gaba_fill_t *gaba_dp_fill_root_none(gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, uint32_t pridx)
+{
+	return(NULL);
+}
+static
+gaba_fill_t *gaba_dp_fill_none(gaba_dp_t *self, gaba_fill_t const *prev_sec, gaba_section_t const *a, gaba_section_t const *b, uint32_t pridx)
+{
+	return(NULL);
+}
+static
+gaba_fill_t *gaba_dp_merge_none(gaba_dp_t *self, gaba_fill_t const *const *sec, uint8_t const *qofs, uint32_t cnt)
+{
+	return(NULL);
+}
+static
+gaba_pos_pair_t *gaba_dp_search_max_none(gaba_dp_t *self, gaba_fill_t const *sec)
+{
+	return(NULL);
+}
+static
+gaba_alignment_t *gaba_dp_trace_none(gaba_dp_t *self, gaba_fill_t const *tail, gaba_alloc_t const *alloc)
+{
+	return(NULL);
+}
+static
+gaba_alignment_t *gaba_dp_extend_screened_none(gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, int64_t threshold, gaba_alloc_t const *alloc)
+{
+	return(NULL);
+}
+static
+gaba_alignment_t *gaba_dp_extend_banded_none(gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc)
+{
+	return(NULL);
+}
+static
+gaba_alignment_t *gaba_dp_align_global_none(gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, uint32_t aend, gaba_section_t const *b, uint32_t bpos, uint32_t bend, gaba_alloc_t const *alloc)
+{
+	return(NULL);
+}
+static
+gaba_alignment_t *gaba_dp_align_local_none(gaba_dp_t *self, gaba_section_t const *a, uint32_t apos, gaba_section_t const *b, uint32_t bpos, gaba_section_t const *tail, gaba_alloc_t const *alloc)
+{
+	return(NULL);
+}
+static
+void *gaba_dp_export_band_none(gaba_dp_t *self, gaba_fill_t const *fill)
+{
+	return(NULL);
+}
+static
+gaba_fill_t *gaba_dp_import_band_none(gaba_dp_t *self, void const *band, gaba_section_t const *a, gaba_section_t const *b)
+{
+	return(NULL);
+}
+static
+void gaba_dp_fill_root_batch_none(gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, uint32_t pridx, gaba_fill_t const **fill)
+{
+	for(uint64_t i = 0; i < cnt; i++) { fill[i] = NULL; }
+	return;
+}
+static
+void gaba_dp_fill_batch_none(gaba_dp_t *self, gaba_seed_t const *seed, uint64_t cnt, gaba_fill_t const **max)
+{
+	for(uint64_t i = 0; i < cnt; i++) { max[i] = NULL; }
+	return;
+}
 
 /* function table */
 _static_assert(GABA_LINEAR == 0);
@@ -159,21 +401,51 @@ _static_assert(GABA_COMBINED == 2);
 _static_assert(_gaba_dp_ctx_index(64) == 0);
 _static_assert(_gaba_dp_ctx_index(32) == 1);
 _static_assert(_gaba_dp_ctx_index(16) == 2);
+_static_assert(_gaba_dp_ctx_index(128) == 3);
+_static_assert(_gaba_dp_ctx_index(256) == 4);
+#define _table_elems(_model, _bw, _arch) { \
+	.dp_fill_root = _import_arch(_decl_cat3(gaba_dp_fill_root, _model, _bw), _arch), \
+	.dp_fill = _import_arch(_decl_cat3(gaba_dp_fill, _model, _bw), _arch), \
+	.dp_merge = _import_arch(_decl_cat3(gaba_dp_merge, _model, _bw), _arch), \
+	.dp_search_max = _import_arch(_decl_cat3(gaba_dp_search_max, _model, _bw), _arch), \
+	.dp_trace = _import_arch(_decl_cat3(gaba_dp_trace, _model, _bw), _arch), \
+	.dp_extend_screened = _import_arch(_decl_cat3(gaba_dp_extend_screened, _model, _bw), _arch), \
+	.dp_extend_banded = _import_arch(_decl_cat3(gaba_dp_extend_banded, _model, _bw), _arch), \
+	.dp_align_global = _import_arch(_decl_cat3(gaba_dp_align_global, _model, _bw), _arch), \
+	.dp_align_local = _import_arch(_decl_cat3(gaba_dp_align_local, _model, _bw), _arch), \
+	.dp_fill_root_batch = _import_arch(_decl_cat3(gaba_dp_fill_root_batch, _model, _bw), _arch), \
+	.dp_fill_batch = _import_arch(_decl_cat3(gaba_dp_fill_batch, _model, _bw), _arch), \
+	.dp_export_band = _import_arch(_decl_cat3(gaba_dp_export_band, _model, _bw), _arch), \
+	.dp_import_band = _import_arch(_decl_cat3(gaba_dp_import_band, _model, _bw), _arch) \
+}
 static
-struct gaba_api_s const api_table[][GABA_DP_CTX_MAX] __attribute__(( aligned(32) )) = {
-	#define _table_elems(_model, _bw) { \
-		.dp_fill_root = _import(_decl_cat3(gaba_dp_fill_root, _model, _bw)), \
-		.dp_fill = _import(_decl_cat3(gaba_dp_fill, _model, _bw)), \
-		.dp_merge = _import(_decl_cat3(gaba_dp_merge, _model, _bw)), \
-		.dp_search_max = _import(_decl_cat3(gaba_dp_search_max, _model, _bw)), \
-		.dp_trace = _import(_decl_cat3(gaba_dp_trace, _model, _bw)) \
+struct gaba_api_s const api_table[GABA_ARCH_MAX][3][GABA_DP_CTX_MAX] __attribute__(( aligned(32) )) = {
+	#define _table_model(_model, _arch) { \
+		_table_elems(_model, 64, _arch), _table_elems(_model, 32, _arch), _table_elems(_model, 16, _arch), \
+		_table_elems(_model, 128, _arch), _table_elems(_model, 256, _arch) \
 	}
 
-	{ _table_elems(linear, 64), _table_elems(linear, 32), _table_elems(linear, 16) },
-	{ _table_elems(affine, 64), _table_elems(affine, 32), _table_elems(affine, 16) },
-	#ifndef DISABLE_COMBINED
-	{ _table_elems(combined, 64), _table_elems(combined, 32), _table_elems(combined, 16) }
-	#endif
+	[GABA_ARCH_SSE41] = {
+		_table_model(linear, sse41),
+		_table_model(affine, sse41),
+		#ifndef DISABLE_COMBINED
+		_table_model(combined, sse41)
+		#endif
+	},
+	[GABA_ARCH_AVX2] = {
+		_table_model(linear, avx2),
+		_table_model(affine, avx2),
+		#ifndef DISABLE_COMBINED
+		_table_model(combined, avx2)
+		#endif
+	},
+	[GABA_ARCH_AVX512] = {
+		_table_model(linear, avx512),
+		_table_model(affine, avx512),
+		#ifndef DISABLE_COMBINED
+		_table_model(combined, avx512)
+		#endif
+	}
 
 	/*
 	[GABA_LINEAR] = {
@@ -194,9 +466,80 @@ struct gaba_api_s const api_table[][GABA_DP_CTX_MAX] __attribute__(( aligned(32)
 	}
 	#endif
 	*/
-	#undef _table_elems
+	#undef _table_model
 };
 
+/* the 128- and 256-cell bands of the presets are the generic affine kernels */
+static
+struct gaba_api_s const api_preset_table[GABA_ARCH_MAX][GABA_PRESET_CNT][GABA_DP_CTX_MAX] __attribute__(( aligned(32) )) = {
+	#define _table_preset(_preset, _arch) { \
+		_table_elems(_preset, 64, _arch), _table_elems(_preset, 32, _arch), _table_elems(_preset, 16, _arch), \
+		_table_elems(affine, 128, _arch), _table_elems(affine, 256, _arch) \
+	}
+	#define _table_preset_arch(_arch) { \
+		_table_preset(preset1, _arch), _table_preset(preset2, _arch), \
+		_table_preset(preset3, _arch), _table_preset(preset4, _arch) \
+	}
+
+	[GABA_ARCH_SSE41] = _table_preset_arch(sse41),
+	[GABA_ARCH_AVX2] = _table_preset_arch(avx2),
+	[GABA_ARCH_AVX512] = _table_preset_arch(avx512)
+
+	#undef _table_preset_arch
+	#undef _table_preset
+};
+
+/* the 16-bit kernels; the 128- and 256-cell bands are the placeholders above */
+static
+struct gaba_api_s const api_diff16_table[GABA_ARCH_MAX][3][GABA_DP_CTX_MAX] __attribute__(( aligned(32) )) = {
+	#define _table_none { \
+		.dp_fill_root = gaba_dp_fill_root_none, \
+		.dp_fill = gaba_dp_fill_none, \
+		.dp_merge = gaba_dp_merge_none, \
+		.dp_search_max = gaba_dp_search_max_none, \
+		.dp_trace = gaba_dp_trace_none, \
+		.dp_extend_screened = gaba_dp_extend_screened_none, \
+		.dp_extend_banded = gaba_dp_extend_banded_none, \
+		.dp_align_global = gaba_dp_align_global_none, \
+		.dp_align_local = gaba_dp_align_local_none, \
+		.dp_fill_root_batch = gaba_dp_fill_root_batch_none, \
+		.dp_fill_batch = gaba_dp_fill_batch_none, \
+		.dp_export_band = gaba_dp_export_band_none, \
+		.dp_import_band = gaba_dp_import_band_none \
+	}
+	#define _table_diff16(_model, _arch) { \
+		_table_elems(_model, 64, _arch), _table_elems(_model, 32, _arch), _table_elems(_model, 16, _arch), \
+		_table_none, _table_none \
+	}
+	#define _table_diff16_arch(_arch) { \
+		_table_diff16(linear16, _arch), _table_diff16(affine16, _arch), _table_diff16(combined16, _arch) \
+	}
+
+	[GABA_ARCH_SSE41] = _table_diff16_arch(sse41),
+	[GABA_ARCH_AVX2] = _table_diff16_arch(avx2),
+	[GABA_ARCH_AVX512] = _table_diff16_arch(avx512)
+
+	#undef _table_diff16_arch
+	#undef _table_diff16
+	#undef _table_none
+};
+#undef _table_elems
+
+/**
+ * @fn gaba_init_get_arch
+ * @brief returns the widest instruction set that the running cpu supports
+ */
+static inline
+int64_t gaba_init_get_arch(void)
+{
+	#if defined(ARCH_DISPATCH) && defined(__x86_64__)
+		uint64_t cap = arch_cap();
+		if((cap & ARCH_CAP_AVX512BW) != 0) { return(GABA_ARCH_AVX512); }
+		if((cap & ARCH_CAP_AVX2) != 0) { return(GABA_ARCH_AVX2); }
+	#endif
+	return(GABA_ARCH_SSE41);		/* all the rows are identical without ARCH_DISPATCH */
+}
+
 /**
  * @fn gaba_init_get_index
  */
@@ -217,6 +560,35 @@ int64_t gaba_init_get_index(
 	return(GABA_LINEAR);
 }
 
+/**
+ * @fn gaba_init_get_preset
+ * @brief returns the index of the scoring preset that the affine-gap params match, -1 if none
+ */
+static inline
+int64_t gaba_init_get_preset(
+	struct gaba_params_s const *params)
+{
+	static struct gaba_params_s const presets[GABA_PRESET_CNT] = {
+		{ GABA_SCORE_PRESET(1) },
+		{ GABA_SCORE_PRESET(2) },
+		{ GABA_SCORE_PRESET(3) },
+		{ GABA_SCORE_PRESET(4) }
+	};
+
+	if(params->gfa != 0 || params->gfb != 0) {
+		return(-1);
+	}
+	for(uint64_t i = 0; i < GABA_PRESET_CNT; i++) {
+		struct gaba_params_s const *q = &presets[i];
+		uint64_t diff = (params->gi != q->gi) | (params->ge != q->ge);
+		for(uint64_t j = 0; j < 16; j++) {
+			diff |= params->score_matrix[j] != q->score_matrix[j];
+		}
+		if(diff == 0) { return(i); }
+	}
+	return(-1);
+}
+
 /**
  * @fn gaba_set_api
  */
@@ -245,15 +617,41 @@ gaba_t *gaba_init(
 		return(NULL);
 	}
 
+	uint64_t arch = gaba_init_get_arch();
 	uint64_t idx = gaba_init_get_index(params);
-	struct gaba_api_s const (*api)[GABA_DP_CTX_MAX] = &api_table[idx];
-
-	static gaba_t *(*const init_table[][GABA_DP_CTX_MAX])(gaba_params_t const *params) = {
-		{ _import(gaba_init_linear_64), _import(gaba_init_linear_32), _import(gaba_init_linear_16) },
-		{ _import(gaba_init_affine_64), _import(gaba_init_affine_32), _import(gaba_init_affine_16) },
-		#ifndef DISABLE_COMBINED
-		{ _import(gaba_init_combined_64), _import(gaba_init_combined_32), _import(gaba_init_combined_16) }
-		#endif
+	int64_t preset = (idx == GABA_AFFINE) ? gaba_init_get_preset(params) : -1;
+	struct gaba_api_s const (*api)[GABA_DP_CTX_MAX] = (preset >= 0) ? &api_preset_table[arch][preset] : &api_table[arch][idx];
+
+	static gaba_t *(*const init_table[GABA_ARCH_MAX][3][GABA_DP_CTX_MAX])(gaba_params_t const *params) = {
+		#define _init_elems(_model, _arch) { \
+			_import_arch(_decl_cat3(gaba_init, _model, 64), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 32), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 16), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 128), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 256), _arch) \
+		}
+		[GABA_ARCH_SSE41] = {
+			_init_elems(linear, sse41),
+			_init_elems(affine, sse41),
+			#ifndef DISABLE_COMBINED
+			_init_elems(combined, sse41)
+			#endif
+		},
+		[GABA_ARCH_AVX2] = {
+			_init_elems(linear, avx2),
+			_init_elems(affine, avx2),
+			#ifndef DISABLE_COMBINED
+			_init_elems(combined, avx2)
+			#endif
+		},
+		[GABA_ARCH_AVX512] = {
+			_init_elems(linear, avx512),
+			_init_elems(affine, avx512),
+			#ifndef DISABLE_COMBINED
+			_init_elems(combined, avx512)
+			#endif
+		}
+		#undef _init_elems
 	};
 
 	/*
@@ -278,15 +676,44 @@ gaba_t *gaba_init(
 	};
 	*/
 
+	/* the 16-bit kernels, tried when the params exceed the 8-bit difference lanes */
+	static gaba_t *(*const init_diff16_table[GABA_ARCH_MAX][3][3])(gaba_params_t const *params) = {
+		#define _init_diff16_elems(_model, _arch) { \
+			_import_arch(_decl_cat3(gaba_init, _model, 64), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 32), _arch), \
+			_import_arch(_decl_cat3(gaba_init, _model, 16), _arch) \
+		}
+		#define _init_diff16_arch(_arch) { \
+			_init_diff16_elems(linear16, _arch), _init_diff16_elems(affine16, _arch), _init_diff16_elems(combined16, _arch) \
+		}
+		[GABA_ARCH_SSE41] = _init_diff16_arch(sse41),
+		[GABA_ARCH_AVX2] = _init_diff16_arch(avx2),
+		[GABA_ARCH_AVX512] = _init_diff16_arch(avx512)
+		#undef _init_diff16_arch
+		#undef _init_diff16_elems
+	};
+
 	/* create context */
 	gaba_params_t p = *params;
 	gaba_t *ctx = NULL;
-	ctx = init_table[idx][_gaba_dp_ctx_index(16)](&p);
+	ctx = init_table[arch][idx][_gaba_dp_ctx_index(16)](&p);
+	if(ctx == NULL) {
+		/* 16-bit kernels; the root blocks of the 128- and 256-cell bands are left uninitialized */
+		if((ctx = init_diff16_table[arch][idx][_gaba_dp_ctx_index(16)](&p)) == NULL) {
+			return(NULL);
+		}
+		p.reserved = (void *)ctx;
+		ctx = init_diff16_table[arch][idx][_gaba_dp_ctx_index(32)](&p);
+		ctx = init_diff16_table[arch][idx][_gaba_dp_ctx_index(64)](&p);
+		return((gaba_t *)gaba_set_api((void *)ctx, &api_diff16_table[arch][idx]));
+	}
 
-	/* init 32-cell and 64-cell wide root blocks */
+	/* init 32-, 64-, 128-, and 256-cell wide root blocks */
 	p.reserved = (void *)ctx;
-	ctx = init_table[idx][_gaba_dp_ctx_index(32)](&p);
-	ctx = init_table[idx][_gaba_dp_ctx_index(64)](&p);
+	ctx = init_table[arch][idx][_gaba_dp_ctx_index(32)](&p);
+	ctx = init_table[arch][idx][_gaba_dp_ctx_index(64)](&p);
+	ctx = init_table[arch][idx][_gaba_dp_ctx_index(128)](&p);
+	ctx = init_table[arch][idx][_gaba_dp_ctx_index(256)](&p);
 	return((gaba_t *)gaba_set_api((void *)ctx, api));
 }
 
@@ -298,7 +725,8 @@ void gaba_clean(
 	gaba_t *ctx)
 {
 	// _api(ctx)->clean(ctx);
-	_import(gaba_clean_linear_64)(ctx);
+	/* contexts and results have the same layout among instruction sets; the sse4.1 build is used for the common functions */
+	_import_arch(gaba_clean_linear_64, sse41)(ctx);
 	return;
 }
 
@@ -309,7 +737,7 @@ _GABA_WRAP_EXPORT_LEVEL
 gaba_dp_t *gaba_dp_init(
 	gaba_t const *ctx)
 {
-	return((gaba_dp_t *)gaba_set_api((void *)_import(gaba_dp_init_linear_64)(ctx), _api_array(ctx)));
+	return((gaba_dp_t *)gaba_set_api((void *)_import_arch(gaba_dp_init_linear_64, sse41)(ctx), _api_array(ctx)));
 }
 
 /**
@@ -319,10 +747,43 @@ _GABA_WRAP_EXPORT_LEVEL
 void gaba_dp_flush(
 	gaba_dp_t *self)
 {
-	_import(gaba_dp_flush_linear_64)(self);
+	_import_arch(gaba_dp_flush_linear_64, sse41)(self);
 	return;
 }
 
+/**
+ * @fn gaba_dp_set_fill_mode
+ */
+_GABA_WRAP_EXPORT_LEVEL
+uint32_t gaba_dp_set_fill_mode(
+	gaba_dp_t *self,
+	uint32_t mode)
+{
+	return(_import_arch(gaba_dp_set_fill_mode_linear_64, sse41)(self, mode));
+}
+
+/**
+ * @fn gaba_dp_set_xdrop
+ */
+_GABA_WRAP_EXPORT_LEVEL
+int32_t gaba_dp_set_xdrop(
+	gaba_dp_t *self,
+	int32_t xdrop)
+{
+	return(_import_arch(gaba_dp_set_xdrop_linear_64, sse41)(self, xdrop));
+}
+
+/**
+ * @fn gaba_dp_set_anchor
+ */
+_GABA_WRAP_EXPORT_LEVEL
+int64_t gaba_dp_set_anchor(
+	gaba_dp_t *self,
+	int64_t diag)
+{
+	return(_import_arch(gaba_dp_set_anchor_linear_64, sse41)(self, diag));
+}
+
 /**
  * @fn gaba_dp_save_stack
  */
@@ -330,7 +791,7 @@ _GABA_WRAP_EXPORT_LEVEL
 gaba_stack_t const *gaba_dp_save_stack(
 	gaba_dp_t *self)
 {
-	return(_import(gaba_dp_save_stack_linear_64)(self));
+	return(_import_arch(gaba_dp_save_stack_linear_64, sse41)(self));
 }
 
 /**
@@ -341,7 +802,7 @@ void gaba_dp_flush_stack(
 	gaba_dp_t *self,
 	gaba_stack_t const *stack)
 {
-	_import(gaba_dp_flush_stack_linear_64)(self, stack);
+	_import_arch(gaba_dp_flush_stack_linear_64, sse41)(self, stack);
 	return;
 }
 
@@ -352,7 +813,7 @@ _GABA_WRAP_EXPORT_LEVEL
 void gaba_dp_clean(
 	gaba_dp_t *self)
 {
-	_import(gaba_dp_clean_linear_64)(self);
+	_import_arch(gaba_dp_clean_linear_64, sse41)(self);
 	return;
 }
 
@@ -371,6 +832,35 @@ gaba_fill_t *gaba_dp_fill_root(
 	return(_api(self)->dp_fill_root(self, a, apos, b, bpos, pridx));
 }
 
+/**
+ * @fn gaba_dp_fill_root_batch
+ */
+_GABA_WRAP_EXPORT_LEVEL
+void gaba_dp_fill_root_batch(
+	gaba_dp_t *self,
+	gaba_seed_t const *seed,
+	uint64_t cnt,
+	uint32_t pridx,
+	gaba_fill_t const **fill)
+{
+	_api(self)->dp_fill_root_batch(self, seed, cnt, pridx, fill);
+	return;
+}
+
+/**
+ * @fn gaba_dp_fill_batch
+ */
+_GABA_WRAP_EXPORT_LEVEL
+void gaba_dp_fill_batch(
+	gaba_dp_t *self,
+	gaba_seed_t const *seed,
+	uint64_t cnt,
+	gaba_fill_t const **max)
+{
+	_api(self)->dp_fill_batch(self, seed, cnt, max);
+	return;
+}
+
 /**
  * @fn gaba_dp_fill
  * @brief fill dp matrix inside section pairs
@@ -423,6 +913,123 @@ gaba_alignment_t *gaba_dp_trace(
 	return(_api(self)->dp_trace(self, tail, alloc));
 }
 
+/**
+ * @fn gaba_dp_extend_screened
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_screened(
+	gaba_dp_t *self,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	int64_t threshold,
+	gaba_alloc_t const *alloc)
+{
+	return(_api(self)->dp_extend_screened(self, a, apos, b, bpos, tail, threshold, alloc));
+}
+
+/**
+ * @fn gaba_dp_extend_banded
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_banded(
+	gaba_dp_t *self,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc)
+{
+	return(_api(self)->dp_extend_banded(self, a, apos, b, bpos, tail, alloc));
+}
+
+/**
+ * @fn gaba_dp_align_global
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_align_global(
+	gaba_dp_t *self,
+	gaba_section_t const *a,
+	uint32_t apos,
+	uint32_t aend,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	uint32_t bend,
+	gaba_alloc_t const *alloc)
+{
+	return(_api(self)->dp_align_global(self, a, apos, aend, b, bpos, bend, alloc));
+}
+
+/**
+ * @fn gaba_dp_align_local
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_align_local(
+	gaba_dp_t *self,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc)
+{
+	return(_api(self)->dp_align_local(self, a, apos, b, bpos, tail, alloc));
+}
+
+/**
+ * @fn gaba_dp_extend_adaptive
+ * @brief starts on the 16-cell band and widens it only when the band looks too narrow
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_alignment_t *gaba_dp_extend_adaptive(
+	gaba_dp_t *dp,
+	gaba_section_t const *a,
+	uint32_t apos,
+	gaba_section_t const *b,
+	uint32_t bpos,
+	gaba_section_t const *tail,
+	gaba_alloc_t const *alloc)
+{
+	/* the narrower bands are discarded if the max is on the edge or the path runs along (or out of) the edge */
+	gaba_alignment_t *r = NULL;
+	if((r = gaba_dp_extend_banded(&dp[_gaba_dp_ctx_index(16)], a, apos, b, bpos, tail, alloc)) != NULL) { return(r); }
+	if((r = gaba_dp_extend_banded(&dp[_gaba_dp_ctx_index(32)], a, apos, b, bpos, tail, alloc)) != NULL) { return(r); }
+
+	/* the widest one is traced as is */
+	gaba_dp_t *d = &dp[_gaba_dp_ctx_index(64)];
+	gaba_section_t const *as = a, *bs = b;
+	gaba_fill_t const *f = gaba_dp_fill_root(d, as, apos, bs, bpos, 0), *m = f;
+	while((f->status & GABA_TERM) == 0) {
+		if(f->status & GABA_UPDATE_A) { as = tail; }
+		if(f->status & GABA_UPDATE_B) { bs = tail; }
+		if(as == NULL || bs == NULL) { break; }
+		f = gaba_dp_fill(d, f, as, bs, 0);
+		m = f->max > m->max ? f : m;
+	}
+	return(gaba_dp_trace(d, m, alloc));
+}
+
+/**
+ * @fn gaba_dp_convert
+ * @brief moves the fill to the kernel of the other band width, through the width-independent copy of the last vector
+ */
+_GABA_WRAP_EXPORT_LEVEL
+gaba_fill_t *gaba_dp_convert(
+	gaba_dp_t *dp,
+	gaba_fill_t const *fill,
+	uint32_t bw,
+	gaba_section_t const *a,
+	gaba_section_t const *b)
+{
+	if(bw != 16 && bw != 32 && bw != 64 && bw != 128 && bw != 256) { return(NULL); }
+	void const *band = _api(&dp[_gaba_dp_ctx_index(fill->bw)])->dp_export_band(&dp[_gaba_dp_ctx_index(fill->bw)], fill);
+	if(band == NULL) { return(NULL); }
+	return(_api(&dp[_gaba_dp_ctx_index(bw)])->dp_import_band(&dp[_gaba_dp_ctx_index(bw)], band, a, b));
+}
+
 /**
  * @fn gaba_dp_res_free
  */
@@ -431,7 +1038,7 @@ void gaba_dp_res_free(
 	gaba_dp_t *dp,
 	gaba_alignment_t *res)
 {
-	_import(gaba_dp_res_free_linear_64)(dp, res);
+	_import_arch(gaba_dp_res_free_linear_64, sse41)(dp, res);
 	return;
 }
 
@@ -446,7 +1053,7 @@ gaba_score_t *gaba_dp_calc_score(
 	gaba_section_t const *a,
 	gaba_section_t const *b)
 {
-	return(_import(gaba_dp_calc_score_linear_64)(dp, path, s, a, b));
+	return(_import_arch(gaba_dp_calc_score_linear_64, sse41)(dp, path, s, a, b));
 }
 
 #if 0
@@ -681,6 +1288,23 @@ unittest()
 	assert(c == NULL);
 }
 
+/* instruction set selection */
+unittest()
+{
+	int64_t arch = gaba_init_get_arch();
+	assert(arch >= GABA_ARCH_SSE41 && arch < GABA_ARCH_MAX, "%lld", arch);
+	assert(api_table[arch][GABA_LINEAR][_gaba_dp_ctx_index(32)].dp_fill != NULL);
+}
+
+/* scoring presets */
+unittest()
+{
+	assert(gaba_init_get_preset(GABA_PARAMS(GABA_SCORE_PRESET(1))) == 0);
+	assert(gaba_init_get_preset(GABA_PARAMS(GABA_SCORE_SIMPLE(1, 1, 1, 1))) == 1);
+	assert(gaba_init_get_preset(GABA_PARAMS(GABA_SCORE_SIMPLE(2, 3, 5, 2))) == -1);
+	assert(gaba_init_get_preset(GABA_PARAMS(GABA_SCORE_PRESET(1), .gfa = 2, .gfb = 2)) == -1);
+}
+
 /* linear gap penalty */
 unittest()
 {
@@ -751,6 +1375,115 @@ unittest(with_seq_pair("GGAAAAAAAA", "AAAAAAAA"))
 	gaba_clean(c);	
 }
 
+/* scores exceeding the 8-bit difference lanes fall back to the 16-bit kernels */
+unittest(with_seq_pair("GGAAAAAAAA", "AAAAAAAA"))
+{
+	omajinai();
+
+	gaba_t *c = gaba_init(GABA_PARAMS(GABA_SCORE_SIMPLE(10, 15, 20, 5)));
+	assert(c != NULL);
+	gaba_dp_t *d = gaba_dp_init(c);
+
+	gaba_fill_t *f = gaba_dp_fill_root(d, &s->afsec, 0, &s->bfsec, 0, 0);
+	f = gaba_dp_fill(d, f, &s->afsec, &s->bftail, 0);
+	f = gaba_dp_fill(d, f, &s->aftail, &s->bftail, 0);
+	assert(f->max == 50, "%lld", f->max);
+
+	gaba_alignment_t *r = gaba_dp_trace(d, f, NULL);
+	assert(r != NULL);
+	assert(r->score == 50, "%lld", r->score);
+
+	/* the 128- and 256-cell bands are not available */
+	assert(gaba_dp_fill_root((gaba_dp_t *)&((struct gaba_api_s *)d)[_gaba_dp_ctx_index(128)], &s->afsec, 0, &s->bfsec, 0, 0) == NULL);
+
+	gaba_dp_clean(d);
+	gaba_clean(c);
+}
+
+/* a 13-base insertion does not fit in the 16-cell band; the adaptive extension escalates to 32 */
+unittest(with_seq_pair(
+	"TTAGTTGTGCCGCAGCGAAGTAGTGCTTGAAATATGCGACCCCTAAGTAGGAGCGTATGCTGCCTGTTGAGATGCCAGACGCGTAACCAAAACATAGAAACCATCAATAGACAGGTCATA",
+	"TTAGTTGTGCCGCAGCGAAGTAGTGCTTGAAATATGCGACCCCTAAGTAGGAGCGTATGCGCCCAGTAACCAATGCCTGTTGAGATGCCAGACGCGTAACCAAAACATAGAAACCATCAATAGACAGGTCATA"))
+{
+	omajinai();
+
+	gaba_t *c = gaba_init(GABA_PARAMS(.xdrop = 100, GABA_SCORE_SIMPLE(2, 3, 5, 1)));
+	gaba_dp_t *d = gaba_dp_init(c);
+	struct gaba_api_s *api = (struct gaba_api_s *)d;
+	static uint8_t const t[64] = { 0 };
+	gaba_section_t const tail = gaba_build_section(6, t, 64);
+
+	assert(gaba_dp_extend_banded((gaba_dp_t *)&api[_gaba_dp_ctx_index(16)], &s->afsec, 0, &s->bfsec, 0, &tail, NULL) == NULL);
+	gaba_alignment_t *r = gaba_dp_extend_banded((gaba_dp_t *)&api[_gaba_dp_ctx_index(32)], &s->afsec, 0, &s->bfsec, 0, &tail, NULL);
+	assert(r != NULL);
+	assert(r->score == 222, "%lld", r->score);
+
+	gaba_alignment_t *x = gaba_dp_extend_adaptive(d, &s->afsec, 0, &s->bfsec, 0, &tail, NULL);
+	assert(x != NULL);
+	assert(x->score == 222, "%lld", x->score);
+
+	gaba_dp_clean(d);
+	gaba_clean(c);
+}
+
+/* the same insertion passed by widening the band to 64 cells just before it, and narrowing back to 16 after it */
+unittest(with_seq_pair(
+	"TTAGTTGTGCCGCAGCGAAGTAGTGCTTGAAATATGCGACCCCTAAGTAGGAGCGTATGCTGCCTGTTGAGATGCCAGACGCGTAACCAAAACATAGAAACCATCAATAGACAGGTCATA",
+	"TTAGTTGTGCCGCAGCGAAGTAGTGCTTGAAATATGCGACCCCTAAGTAGGAGCGTATGCGCCCAGTAACCAATGCCTGTTGAGATGCCAGACGCGTAACCAAAACATAGAAACCATCAATAGACAGGTCATA"))
+{
+	omajinai();
+
+	gaba_t *c = gaba_init(GABA_PARAMS(.xdrop = 100, GABA_SCORE_SIMPLE(2, 3, 5, 1)));
+	gaba_dp_t *d = gaba_dp_init(c);
+	struct gaba_api_s *api = (struct gaba_api_s *)d;
+	static uint8_t const t[64] = { 0 };
+	gaba_section_t const as[4] = {
+		gaba_build_section(0, s->a, 40), gaba_build_section(2, s->a + 40, 50), gaba_build_section(4, s->a + 90, 30), gaba_build_section(12, t, 64)
+	};
+	gaba_section_t const bs[4] = {
+		gaba_build_section(6, s->b, 40), gaba_build_section(8, s->b + 40, 63), gaba_build_section(10, s->b + 103, 30), gaba_build_section(14, t, 64)
+	};
+
+	/* widened when the fronts enter the second sections, narrowed at the next update retreating on the finished section */
+	gaba_section_t const *a = &as[0], *b = &bs[0];
+	gaba_fill_t const *f = gaba_dp_fill_root((gaba_dp_t *)&api[_gaba_dp_ctx_index(16)], a, 0, b, 0, 0), *m = f;
+	uint64_t cnt = 0;
+	while((f->status & GABA_TERM) == 0) {
+		gaba_section_t const *pa = a, *pb = b;
+		a += (f->status & GABA_UPDATE_A) != 0 && a != &as[3];
+		b += (f->status & GABA_UPDATE_B) != 0 && b != &bs[3];
+		if(cnt == 0 && a == &as[1]) {
+			gaba_fill_t const *cf = gaba_dp_convert(d, f, 64, a, b);
+			assert(cf != NULL);
+			assert(cf->bw == 64 && cf->max == f->max, "bw(%u), max(%lld, %lld)", cf->bw, cf->max, f->max);
+			f = cf; cnt++;
+		} else if(cnt == 1) {
+			gaba_fill_t const *cf = gaba_dp_convert(d, f, 16, pa, pb);
+			assert(cf != NULL);
+			assert(cf->bw == 16 && cf->max == f->max, "bw(%u), max(%lld, %lld)", cf->bw, cf->max, f->max);
+			f = cf; cnt++;
+			a = pa + ((f->status & GABA_UPDATE_A) != 0);
+			b = pb + ((f->status & GABA_UPDATE_B) != 0);
+		}
+		f = gaba_dp_fill((gaba_dp_t *)&api[_gaba_dp_ctx_index(f->bw)], f, a, b, 0);
+		m = f->max > m->max ? f : m;
+	}
+	assert(cnt == 2, "%lu", cnt);
+	assert(f->bw == 16, "%u", f->bw);
+	assert(m->max == 222, "%lld", m->max);
+
+	gaba_alignment_t *r = gaba_dp_trace((gaba_dp_t *)&api[_gaba_dp_ctx_index(m->bw)], m, NULL);
+	assert(r != NULL);
+	assert(r->score == 222, "%lld", r->score);
+	assert(r->agcnt + r->bgcnt == 13, "%u, %u", r->agcnt, r->bgcnt);
+
+	/* out-of-range widths are rejected */
+	assert(gaba_dp_convert(d, f, 48, a, b) == NULL);
+
+	gaba_dp_clean(d);
+	gaba_clean(c);
+}
+
 #endif	/* UNITTEST != 0 */
 #endif	/* _GABA_WRAP_H_INCLUDED */
 